@@ -0,0 +1,102 @@
+/**
+ * run the library against a simulated lossy link with a virtual clock to tune update rates and timeouts without field trials
+ * no WiFi connection or mobile app needed. Each scenario simulates 60 seconds of traffic in a moment
+ */
+
+#include <WiFi_Joystick_Controller.h>
+#include <WJC_Link_Simulator.h>
+
+// virtual clock shared between the simulated link and the library instance
+unsigned long virtualTime_ms = 0;
+unsigned long virtualClock() {
+  return virtualTime_ms;
+}
+
+// simulated link and the library instance receiving from it
+WJC_Link_Simulator simLink(virtualClock, 1);
+WiFi_Joystick_Controller remote(&simLink, 8888);
+
+// simulated mobile app settings
+const uint16_t sendPeriod_ms = 50;        // data send period of the mobile app
+const unsigned long duration_ms = 60000;  // simulated time per scenario
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  // no WiFi needed for the simulated link
+  remote.init(true);
+  remote.setClock(virtualClock);
+  remote.setDataValidTimeout(500);
+
+  // loss %, delay ms, jitter ms, duplicate %, reorder %
+  simLink.setImpairment(10, 20, 30, 5, 5);
+
+  Serial.println("update_ms\tdelivered\tsuperseded\tlatency min/avg/max\tstale avg/max\ttimeouts_ms");
+
+  // compare receive modes by update() period
+  const uint16_t updatePeriods_ms[] = { 1, 10, 25, 50, 100 };
+  for (uint8_t i = 0; i < sizeof(updatePeriods_ms) / sizeof(updatePeriods_ms[0]); i++) {
+    runScenario(updatePeriods_ms[i]);
+  }
+}
+
+void loop() {
+  // do nothing
+}
+
+void runScenario(uint16_t updatePeriod_ms) {
+  char packet[128];
+  uint16_t frameId = 0;
+  unsigned long staleSum_ms = 0;
+  unsigned long staleMax_ms = 0;
+  unsigned long timeout_ms = 0;
+
+  simLink.resetStats();
+
+  unsigned long start_ms = virtualTime_ms;
+  for (; virtualTime_ms - start_ms < duration_ms; virtualTime_ms++) {
+    // simulated mobile app
+    if ((virtualTime_ms - start_ms) % sendPeriod_ms == 0) {
+      int8_t stick = (int8_t)((virtualTime_ms / 10) % 200 - 100);
+      int length = snprintf(packet, sizeof(packet), "{\"WJC\":1,\"fid\":%u,\"jsLx\":%d,\"jsLy\":0,\"jsRx\":0,\"jsRy\":0,\"bgA\":0,\"bgmA\":0,\"bgB\":0,\"bgmB\":0}", frameId++, stick);
+      simLink.transmit(packet, length);
+    }
+
+    // sketch loop calling update() at the selected period
+    if ((virtualTime_ms - start_ms) % updatePeriod_ms == 0) {
+      while (remote.update() != 2) {
+        // drain all packets arrived since last update
+      }
+    }
+
+    // staleness of the data the sketch would act on
+    unsigned long age_ms = remote.getDataAge();
+    staleSum_ms += age_ms;
+    staleMax_ms = max(staleMax_ms, age_ms);
+    if (remote.getDataValidStatus() != WJC_ERR_OK) {
+      timeout_ms++;
+    }
+  }
+
+  WJC_Link_Stats_t stats;
+  simLink.getStats(stats);
+
+  Serial.print(updatePeriod_ms);
+  Serial.print('\t');
+  Serial.print(stats.delivered);
+  Serial.print('\t');
+  Serial.print(stats.superseded);
+  Serial.print('\t');
+  Serial.print(stats.latencyMin);
+  Serial.print('/');
+  Serial.print(stats.latencyAvg);
+  Serial.print('/');
+  Serial.print(stats.latencyMax);
+  Serial.print('\t');
+  Serial.print(staleSum_ms / duration_ms);
+  Serial.print('/');
+  Serial.print(staleMax_ms);
+  Serial.print('\t');
+  Serial.println(timeout_ms);
+}
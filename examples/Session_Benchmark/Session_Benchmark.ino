@@ -0,0 +1,136 @@
+/**
+ * measure the per-packet cost of session mode authentication on the development board
+ * no WiFi connection or mobile app needed. Packets are built and injected through an in-memory transport
+ */
+
+#include <WiFi_Joystick_Controller.h>
+
+// in-memory transport and the library instance receiving from it
+WJC_Loopback_Transport loopback;
+WiFi_Joystick_Controller remote(&loopback, 8888);
+
+// pre-shared session key. Replace with your own random key on both sides
+const uint8_t sessionKey[WJC_SESSION_KEY_SIZE] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                   0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F };
+
+// simulated mobile app
+const IPAddress appIP(192, 168, 4, 2);
+const uint16_t appPort = 50000;
+const IPAddress strangerIP(192, 168, 4, 3);
+uint32_t packetCounter;
+
+const uint16_t iterations = 1000;  // repetitions per measurement
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  // no WiFi needed for the in-memory transport
+  remote.init(true);
+  if (remote.setSessionKey(sessionKey) != WJC_ERR_OK) {
+    Serial.println("No usable random number generator for session challenges");
+    while (true) {
+      // cannot continue with no session
+    }
+  }
+
+  // realistic data packets: plain frame, frame with a redundant copy, and with timestamp tags as well
+  const char *frames[] = {
+    "{\"WJC\":1,\"fid\":65535,\"jsLx\":-100,\"jsLy\":-100,\"jsRx\":-100,\"jsRy\":-100,\"bgA\":7,\"bgmA\":1,\"bgB\":7,\"bgmB\":1}",
+    "{\"WJC\":1,\"fid\":65535,\"jsLx\":-100,\"jsLy\":-100,\"jsRx\":-100,\"jsRy\":-100,\"bgA\":7,\"bgmA\":1,\"bgB\":7,\"bgmB\":1,"
+    "\"prv\":{\"fid\":65534,\"jsLx\":-100,\"jsLy\":-100,\"jsRx\":-100,\"jsRy\":-100,\"bgA\":7,\"bgmA\":1,\"bgB\":7,\"bgmB\":1}}",
+    "{\"WJC\":1,\"fid\":65535,\"jsLx\":-100,\"jsLy\":-100,\"jsRx\":-100,\"jsRy\":-100,\"bgA\":7,\"bgmA\":1,\"bgB\":7,\"bgmB\":1,"
+    "\"ts\":4294967295,\"ets\":4294967295,\"eh\":65535,"
+    "\"prv\":{\"fid\":65534,\"jsLx\":-100,\"jsLy\":-100,\"jsRx\":-100,\"jsRy\":-100,\"bgA\":7,\"bgmA\":1,\"bgB\":7,\"bgmB\":1}}"
+  };
+
+  // pin the session to the simulated mobile app
+  startSession();
+
+  Serial.println("bytes\ttag_us\tverify_us\tstranger_us");
+  for (uint8_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++) {
+    runBenchmark(frames[i]);
+  }
+}
+
+void loop() {
+  // do nothing
+}
+
+void startSession() {
+  char reply[WJC_SESSION_CHALLENGE_SIZE];
+
+  // request a challenge and take the nonce as the first packet counter
+  loopback.inject("WJSN\0\0\0\0", WJC_SESSION_CHALLENGE_SIZE, appIP, appPort);
+  remote.update(false);
+  loopback.getSentPacket(reply, sizeof(reply));
+  packetCounter = (uint32_t)(uint8_t)reply[4] | ((uint32_t)(uint8_t)reply[5] << 8) | ((uint32_t)(uint8_t)reply[6] << 16) | ((uint32_t)(uint8_t)reply[7] << 24);
+
+  // first authenticated packet answers the challenge
+  char packet[WJC_MAX_PACKET_SIZE];
+  const char frame[] = "{\"WJC\":1}";
+  uint16_t length = buildPacket(packet, frame, strlen(frame));
+  loopback.inject(packet, length, appIP, appPort);
+  remote.update(false);
+
+  if (remote.getSessionStatus() != WJC_ERR_OK) {
+    Serial.println("Session cannot pinned");
+    while (true) {
+      // cannot continue with no session
+    }
+  }
+}
+
+uint16_t buildPacket(char *packet, const char *frame, uint16_t frameLength) {
+  // [0..7] tag, [8..11] counter, [12..] data packet
+  for (uint8_t i = 0; i < 4; i++) {
+    packet[8 + i] = (char)(packetCounter >> (8 * i));
+  }
+  packetCounter++;
+  memcpy(&packet[WJC_SESSION_HEADER_SIZE], frame, frameLength);
+
+  uint64_t tag = remote.calcPacketTag((const uint8_t *)&packet[8], frameLength + 4);
+  for (uint8_t i = 0; i < 8; i++) {
+    packet[i] = (char)(tag >> (8 * i));
+  }
+
+  return frameLength + WJC_SESSION_HEADER_SIZE;
+}
+
+void runBenchmark(const char *frame) {
+  char packet[WJC_MAX_PACKET_SIZE];
+  uint16_t frameLength = strlen(frame);
+  unsigned long tagTime_us = 0;
+  unsigned long verifyTime_us = 0;
+  unsigned long strangerTime_us = 0;
+
+  for (uint16_t i = 0; i < iterations; i++) {
+    uint16_t length = buildPacket(packet, frame, frameLength);
+
+    // tag calculation alone
+    unsigned long start_us = micros();
+    remote.calcPacketTag((const uint8_t *)&packet[8], length - 8);
+    tagTime_us += micros() - start_us;
+
+    // forged packet from the pinned host. Dropped after the tag check
+    packet[0] ^= 0x01;
+    loopback.inject(packet, length, appIP, appPort);
+    start_us = micros();
+    remote.update(false);
+    verifyTime_us += micros() - start_us;
+
+    // packet from another host. Dropped before reading
+    loopback.inject(packet, length, strangerIP, appPort);
+    start_us = micros();
+    remote.update(false);
+    strangerTime_us += micros() - start_us;
+  }
+
+  Serial.print(frameLength + WJC_SESSION_HEADER_SIZE);
+  Serial.print('\t');
+  Serial.print((float)tagTime_us / iterations);
+  Serial.print('\t');
+  Serial.print((float)verifyTime_us / iterations);
+  Serial.print('\t');
+  Serial.println((float)strangerTime_us / iterations);
+}
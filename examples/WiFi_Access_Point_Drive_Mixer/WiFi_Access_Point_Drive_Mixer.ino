@@ -0,0 +1,78 @@
+/**
+ * configure development platform as a WiFi Access Point and drive a differential drive robot from the mobile app
+ * the mixer converts joystick data into motor outputs inside update(), so the loop only writes them to the motor driver
+ * see WiFi_Access_Point example for more details
+ */
+
+#include <WiFi_Joystick_Controller.h>
+#include <WJC_Mixer.h>
+
+// WiFi network credentials
+const char* ssid = "YOUR_AP_NAME";   // replace with a desired name
+const char* pswd = "YOUR_PASSWORD";  // replace with a desired password
+const uint16_t udpPort = 8888;       // replace with desired UDP port number
+
+// WiFi remote controller object
+WiFi_Joystick_Controller remote(udpPort);
+
+// mixer object. Replace with WJC_Tank_Mixer, WJC_Mecanum_Mixer or WJC_Servo_Mixer for other drive setups
+WJC_Arcade_Mixer mixer(WJC_LEFT_JOYSTICK);
+int16_t motorOutputs[2];  // must hold mixer.getOutputCount() values
+
+// loop rate maintaining variables
+unsigned long lastUpdated_ms;        // timestamp of last update
+unsigned long lastPrinted_ms;        // timestamp of last serial print performed
+const uint16_t updateDelay_ms = 25;  // keep this value below half of the mobile app's data send period
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  // initialize WiFi AP and get the status
+  uint8_t wifiStatus = remote.init(WJC_WIFI_MODE_AP, ssid, pswd);
+
+  // validate the WiFi status
+  if (wifiStatus != WJC_ERR_OK) {
+    Serial.print("Remote AP initialization error: ");
+    Serial.print(wifiStatus);
+    while (true) {
+      // cannot continue with no WiFi establishment
+    }
+  }
+
+  // use following data to set the "UDP Credentials" of the mobile app
+  Serial.print("Remote AP initialized at IP Address ");
+  Serial.print(remote.getIpAddress());
+  Serial.print(" with the UDP port number ");
+  Serial.println(remote.getPortNumber());
+
+  // set timeout (milliSeconds) for data validation period
+  remote.setDataValidTimeout(500);
+
+  // motor outputs in (-255) - 255 range. Replace with the range of your motor driver
+  mixer.setOutputRange(-255, 0, 255);
+  remote.setMixer(&mixer, motorOutputs);
+}
+
+void loop() {
+  // make sure to run update() at least x2 speed of the mobile app's data rate to maintain performance
+  if (millis() - lastUpdated_ms >= updateDelay_ms) {
+    // motorOutputs are updated for every accepted data packet
+    // if no valid data received during the given period, they are set to neutral (stopped motors, centered servos)
+    remote.update();
+
+    // write motorOutputs to your motor driver here
+
+    lastUpdated_ms = millis();  // update timestamp
+  }
+
+  // rest of the loop. Replace with your own functions. Do not call delay() or time expensive functions
+  if (millis() - lastPrinted_ms > updateDelay_ms * 5) {
+    Serial.print(motorOutputs[WJC_MIX_LEFT_MOTOR]);
+    Serial.print('\t');
+    Serial.println(motorOutputs[WJC_MIX_RIGHT_MOTOR]);
+    lastPrinted_ms = millis();
+  }
+
+  // do not call delay()
+}
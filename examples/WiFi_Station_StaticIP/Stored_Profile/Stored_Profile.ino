@@ -0,0 +1,106 @@
+/**
+ * configure development platform as a WiFi station that reuses the network profile of the previous boot
+ * first boot connects normally and stores the channel and BSSID. Later boots skip the scan and still use DHCP
+ * a static profile, stored by the static IP init() while the same store is set, also skips DHCP
+ * make sure that mobile device connected to the development platform's WiFi network
+ */
+
+#include <WiFi_Joystick_Controller.h>
+
+// WiFi network credentials
+// MKR1000: profile is not supported. Every boot uses a full connection
+const char* ssid = "YOUR_SSID";      // replace with SSID of your WiFi network
+const char* pswd = "YOUR_PASSWORD";  // replace with password of your WiFi network
+const uint16_t udpPort = 8888;       // replace with desired UDP port number
+
+// network profile store
+// ESP32: NVS namespace "wjc". ESP8266: EEPROM from address 0 of a 512 byte EEPROM. If the sketch uses EEPROM too,
+// give the same size to EEPROM.begin(), keep its data clear of the profile and do not call EEPROM.end()
+// WJC_File_Profile_Store can keep the profile in a file instead (e.g. WJC_File_Profile_Store profileStore(LittleFS, "/wjc_profile"))
+#if defined(ARDUINO_ARCH_ESP32)
+WJC_NVS_Profile_Store profileStore;
+#elif defined(ARDUINO_ARCH_ESP8266)
+WJC_EEPROM_Profile_Store profileStore(0, 512);
+#else
+WJC_Memory_Profile_Store profileStore;
+#endif
+
+// WiFi remote controller object
+WiFi_Joystick_Controller remote(udpPort);
+
+// loop rate maintaining variables
+unsigned long lastUpdated_ms;        // timestamp of last update
+unsigned long lastPrinted_ms;        // timestamp of last print performed
+const uint16_t updateDelay_ms = 25;  // keep this value below half of the mobile app's data send period
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  // set where the network profile is kept
+  remote.setProfileStore(&profileStore);
+
+  // uncomment to forget the stored network profile
+  // remote.clearStoredProfile();
+
+  // initialize WiFi station using the stored profile when available
+  unsigned long connectStart_ms = millis();
+  uint8_t wifiStatus = remote.initFromProfile(ssid, pswd);
+  unsigned long connectTime_ms = millis() - connectStart_ms;
+
+  // validate the WiFi status
+  if (wifiStatus != WJC_ERR_OK) {
+    Serial.print("Remote STA initialization error: ");
+    Serial.print(wifiStatus);
+    while (true) {
+      // cannot continue with no WiFi establishment
+    }
+  }
+
+  // print which connection path was used
+  if (remote.getConnectPath() == WJC_CONNECT_FAST) {
+    Serial.print("Fast connection using stored profile");
+  } else {
+    Serial.print("Full connection");
+  }
+  Serial.print(" in ");
+  Serial.print(connectTime_ms);
+  Serial.println(" ms");
+
+  // use following data to set the "UDP Credentials" of the mobile app
+  Serial.print("Remote STA initialized at IP Address ");
+  Serial.print(remote.getIpAddress());
+  Serial.print(" with the UDP port number ");
+  Serial.println(remote.getPortNumber());
+
+  // set timeout (milliSeconds) for data validation period
+  remote.setDataValidTimeout(500);
+}
+
+void loop() {
+  // make sure to run update() at least x2 speed of the mobile app's data rate to maintain performance
+  if (millis() - lastUpdated_ms >= updateDelay_ms) {
+    remote.update();  // run this function to update the library internal buffers
+    lastUpdated_ms = millis();  // update timestamp
+  }
+
+  // rest of the loop. Replace with your own functions. Do not call delay() or time expensive functions
+  if (millis() - lastPrinted_ms > updateDelay_ms * 5) {
+    // validate if a valid data packet received during the given period
+    if (remote.getDataValidStatus() == WJC_ERR_OK) {
+      Serial.print(remote.getJoystick(WJC_LEFT_JOYSTICK, WJC_X_AXIS));
+      Serial.print('\t');
+      Serial.print(remote.getJoystick(WJC_LEFT_JOYSTICK, WJC_Y_AXIS));
+      Serial.print('\t');
+      Serial.print(remote.getJoystick(WJC_RIGHT_JOYSTICK, WJC_X_AXIS));
+      Serial.print('\t');
+      Serial.print(remote.getJoystick(WJC_RIGHT_JOYSTICK, WJC_Y_AXIS));
+    } else {
+      Serial.print("No new data available");
+    }
+    Serial.println();
+    lastPrinted_ms = millis();
+  }
+
+  // do not call delay()
+}
@@ -0,0 +1,122 @@
+/**
+ * configure development platform as a WiFi station and merge two mobile apps into a single controller
+ * the instructor app (remote1) takes over whenever its joysticks or buttons are used, otherwise the trainee app (remote2) has control
+ * see WiFi_Station_Multiple_Remotes example for more details
+ */
+
+#include <WiFi_Joystick_Controller.h>
+#include <WJC_Arbiter.h>
+
+// WiFi network credentials
+const char* ssid = "YOUR_SSID";      // replace with SSID of your WiFi network
+const char* pswd = "YOUR_PASSWORD";  // replace with password of your WiFi network
+const uint16_t udpPort1 = 8888;      // replace with desired UDP port number
+const uint16_t udpPort2 = 8889;      // replace with desired UDP port number
+
+// WiFi remote controller objects
+WiFi_Joystick_Controller remote1(udpPort1);  // instructor
+WiFi_Joystick_Controller remote2(udpPort2);  // trainee
+
+// arbiter object. Try WJC_ARB_PRIORITY, WJC_ARB_LAST_ACTIVE, WJC_ARB_SUM or WJC_ARB_AVERAGE for other setups
+WJC_Arbiter arbiter(WJC_ARB_INSTRUCTOR);
+
+// loop rate maintaining variables
+unsigned long lastUpdated_ms;        // timestamp of last update
+unsigned long lastPrinted_ms;        // timestamp of last print performed
+const uint16_t updateDelay_ms = 25;  // keep this value below half of the mobile app's data send period
+
+// merged data holding variables
+int8_t leftJoystickX, leftJoystickY;
+int8_t rightJoystickX, rightJoystickY;
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  // initialize WiFi STA and get the status. Only the first initialization should have WiFi credentials
+  uint8_t wifiStatus1 = remote1.init(WJC_WIFI_MODE_STA, ssid, pswd);
+  uint8_t wifiStatus2 = remote2.init(true);
+
+  // validate the WiFi status
+  if (wifiStatus1 != WJC_ERR_OK || wifiStatus2 != WJC_ERR_OK) {
+    Serial.print("Remote STA initialization error: ");
+    Serial.print(wifiStatus1);
+    Serial.print(" ");
+    Serial.println(wifiStatus2);
+    while (true) {
+      // cannot continue with no WiFi establishment
+    }
+  }
+
+  // use following data to set the "UDP Credentials" of the mobile apps
+  Serial.print("Remote STA initialized at IP Address ");
+  Serial.print(remote1.getIpAddress());
+  Serial.print(" with the UDP port number ");
+  Serial.print(remote1.getPortNumber());
+  Serial.print(" (instructor) and ");
+  Serial.print(remote2.getPortNumber());
+  Serial.println(" (trainee)");
+
+  // set timeout (milliSeconds) for data validation period
+  remote1.setDataValidTimeout(500);
+  remote2.setDataValidTimeout(500);
+
+  // higher priority remote is the instructor
+  arbiter.addRemote(&remote1, 2);
+  arbiter.addRemote(&remote2, 1);
+  arbiter.setInstructorDeadband(10);
+}
+
+void loop() {
+  // make sure to run update() at least x2 speed of the mobile app's data rate to maintain performance
+  if (millis() - lastUpdated_ms >= updateDelay_ms) {
+    remote1.update();
+    remote2.update();
+
+    // merged data is recalculated only when one of the remotes has new data or all of them timed out
+    // 0: merged data changed, 2: no valid remote and merged data is neutral (reported once)
+    if (arbiter.update() != 1) {
+      updateValues();
+    }
+
+    lastUpdated_ms = millis();  // update timestamp
+  }
+
+  // rest of the loop. Replace with your own functions. Do not call delay() or time expensive functions
+  if (millis() - lastPrinted_ms > updateDelay_ms * 5) {
+    uint8_t activeRemote = arbiter.getActiveRemote();
+    if (activeRemote == 0) {
+      Serial.print("Instructor");
+    } else if (activeRemote == 1) {
+      Serial.print("Trainee");
+    } else {
+      Serial.print("No new data available");
+    }
+    Serial.print('\t');
+
+    printValues();
+    Serial.println();
+    lastPrinted_ms = millis();
+  }
+
+  // do not call delay()
+}
+
+void updateValues() {
+  leftJoystickX = arbiter.getJoystick(WJC_LEFT_JOYSTICK, WJC_X_AXIS);
+  leftJoystickY = arbiter.getJoystick(WJC_LEFT_JOYSTICK, WJC_Y_AXIS);
+
+  rightJoystickX = arbiter.getJoystick(WJC_RIGHT_JOYSTICK, WJC_X_AXIS);
+  rightJoystickY = arbiter.getJoystick(WJC_RIGHT_JOYSTICK, WJC_Y_AXIS);
+}
+
+void printValues() {
+  Serial.print(leftJoystickX);
+  Serial.print('\t');
+  Serial.print(leftJoystickY);
+  Serial.print('\t');
+
+  Serial.print(rightJoystickX);
+  Serial.print('\t');
+  Serial.print(rightJoystickY);
+}
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""
+Poll a fleet of boards running the WiFi_Joystick_Controller library for their health records.
+
+Each board must enable the query with setStatsQuery(true). The query is sent to the same UDP port
+the mobile app uses, so no extra socket is needed on the board. Boards in session mode only answer
+authenticated queries, so pass their session key with -k.
+
+usage: wjc_stats_collector.py [-i INTERVAL] [-t TIMEOUT] [-k KEY] HOST:PORT [HOST:PORT ...]
+"""
+
+import argparse
+import socket
+import struct
+import time
+
+QUERY = b"WJSQ"
+RECORD = struct.Struct("<4sBBIIIIIIIHII")
+COUNTER_EPOCH = 1735689600  # 2025-01-01, query counters are tenths of a second since then
+MASK64 = (1 << 64) - 1
+FIELDS = ("uptime_s", "accepted", "decode_err", "invalid", "session_rej", "duplicates", "recovered",
+          "rate_pps", "age_ms", "free_heap")
+
+
+def parse_target(text):
+    host, port = text.rsplit(":", 1)
+    return socket.gethostbyname(host), int(port)
+
+
+def parse_key(text):
+    key = bytes.fromhex(text)
+    if len(key) != 16:
+        raise argparse.ArgumentTypeError("session key must be 16 bytes (32 hex digits)")
+    return key
+
+
+def siphash24(key, data):
+    """SipHash-2-4 as used by the library session mode"""
+    k0, k1 = struct.unpack("<QQ", key)
+    v = [k0 ^ 0x736f6d6570736575, k1 ^ 0x646f72616e646f6d, k0 ^ 0x6c7967656e657261, k1 ^ 0x7465646279746573]
+
+    def rotl(x, b):
+        return ((x << b) | (x >> (64 - b))) & MASK64
+
+    def sip_round():
+        v[0] = (v[0] + v[1]) & MASK64
+        v[1] = rotl(v[1], 13) ^ v[0]
+        v[0] = rotl(v[0], 32)
+        v[2] = (v[2] + v[3]) & MASK64
+        v[3] = rotl(v[3], 16) ^ v[2]
+        v[0] = (v[0] + v[3]) & MASK64
+        v[3] = rotl(v[3], 21) ^ v[0]
+        v[2] = (v[2] + v[1]) & MASK64
+        v[1] = rotl(v[1], 17) ^ v[2]
+        v[2] = rotl(v[2], 32)
+
+    tail = len(data) % 8
+    blocks = [struct.unpack_from("<Q", data, i)[0] for i in range(0, len(data) - tail, 8)]
+    blocks.append(int.from_bytes(data[len(data) - tail:], "little") | ((len(data) & 0xFF) << 56))
+    for m in blocks:
+        v[3] ^= m
+        sip_round()
+        sip_round()
+        v[0] ^= m
+
+    v[2] ^= 0xFF
+    for _ in range(4):
+        sip_round()
+    return v[0] ^ v[1] ^ v[2] ^ v[3]
+
+
+class QueryBuilder:
+    """build plain queries, or authenticated ones with a counter increasing across collector restarts"""
+
+    def __init__(self, key):
+        self.key = key
+        self.counter = 0
+
+    def next(self):
+        if self.key is None:
+            return QUERY
+        self.counter = max(self.counter + 1, int((time.time() - COUNTER_EPOCH) * 10))
+        body = struct.pack("<I", self.counter & 0xFFFFFFFF) + QUERY
+        return struct.pack("<Q", siphash24(self.key, body)) + body
+
+
+def poll(sock, targets, timeout, queries):
+    """send one query to every board and collect the records received before the timeout"""
+    results = {}
+    for target in targets:
+        sock.sendto(queries.next(), target)
+
+    deadline = time.monotonic() + timeout
+    while len(results) < len(targets):
+        remaining = deadline - time.monotonic()
+        if remaining <= 0:
+            break
+        sock.settimeout(remaining)
+        try:
+            data, source = sock.recvfrom(512)
+        except socket.timeout:
+            break
+
+        if source not in targets or len(data) != RECORD.size:
+            continue
+        magic, version, flags, *values = RECORD.unpack(data)
+        if magic != b"WJSR" or version != 1:
+            continue
+
+        values[0] = values[0] // 1000  # uptime in seconds
+        results[source] = (flags, values)
+
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description="WiFi Joystick Controller fleet health collector")
+    parser.add_argument("targets", nargs="+", type=parse_target, help="board address as HOST:PORT")
+    parser.add_argument("-i", "--interval", type=float, default=5.0, help="poll interval in seconds (0 polls once)")
+    parser.add_argument("-t", "--timeout", type=float, default=1.0, help="reply timeout in seconds")
+    parser.add_argument("-k", "--key", type=parse_key, help="session key of the boards as 32 hex digits")
+    args = parser.parse_args()
+
+    queries = QueryBuilder(args.key)
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    header = "{:<22} {:<6} {:<7} ".format("board", "valid", "session") + " ".join("{:>11}".format(f) for f in FIELDS)
+
+    while True:
+        results = poll(sock, args.targets, args.timeout, queries)
+
+        print(time.strftime("%H:%M:%S"))
+        print(header)
+        for target in args.targets:
+            name = "{}:{}".format(*target)
+            if target not in results:
+                print("{:<22} no reply".format(name))
+                continue
+            flags, values = results[target]
+            print("{:<22} {:<6} {:<7} ".format(name, "yes" if flags & 0x01 else "no", "pinned" if flags & 0x02 else "-")
+                  + " ".join("{:>11}".format(v) for v in values))
+        print()
+
+        if args.interval <= 0:
+            break
+        time.sleep(args.interval)
+
+
+if __name__ == "__main__":
+    main()
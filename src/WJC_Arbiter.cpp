@@ -0,0 +1,320 @@
+/**
+ * @file WJC_Arbiter.cpp
+ *
+ * @brief merge several "WiFi Joystick Controller" remotes into a single controller state
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_Arbiter.h"
+
+WJC_Arbiter::WJC_Arbiter(uint8_t policy)
+{
+    _policy = policy;
+}
+
+uint8_t WJC_Arbiter::addRemote(WiFi_Joystick_Controller *remote, uint8_t priority)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (remote == nullptr)
+    {
+        err = 1;
+        return err;
+    }
+
+    if (_remoteCount >= WJC_ARB_MAX_REMOTES)
+    {
+        err = 2;
+        return err;
+    }
+
+    _remotes[_remoteCount] = remote;
+    _priorities[_remoteCount] = priority;
+    _frameCounts[_remoteCount] = remote->getFrameCount();
+    _dataValid[_remoteCount] = false;
+    _lastChanged_ms[_remoteCount] = 0;
+    _lastData[_remoteCount] = remote->getRemoteData();
+    _remoteCount++;
+    _recalculate = true;
+
+    return err;
+}
+
+void WJC_Arbiter::setPolicy(uint8_t policy)
+{
+    _policy = policy;
+    _recalculate = true;
+}
+
+void WJC_Arbiter::setInstructorDeadband(uint8_t deadband)
+{
+    _instructorDeadband = deadband;
+    _recalculate = true;
+}
+
+uint8_t WJC_Arbiter::update(void)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    // collect input changes
+    bool anyValid = false;
+    for (uint8_t i = 0; i < _remoteCount; i++)
+    {
+        bool dataValid = (_remotes[i]->getDataValidStatus() == WJC_ERR_OK);
+        if (dataValid != _dataValid[i])
+        {
+            _dataValid[i] = dataValid;
+            _recalculate = true;
+        }
+
+        uint32_t frameCount = _remotes[i]->getFrameCount();
+        if (frameCount != _frameCounts[i])
+        {
+            _frameCounts[i] = frameCount;
+
+            // only a changed input counts as activity for the last active policy
+            const WJC_Remote_t &data = _remotes[i]->getRemoteData();
+            if (memcmp(&data, &_lastData[i], sizeof(WJC_Remote_t)) != 0)
+            {
+                _lastData[i] = data;
+                _lastChanged_ms[i] = _now();
+                _recalculate = true;
+            }
+        }
+
+        anyValid |= dataValid;
+    }
+
+    if (!_recalculate)
+    {
+        err = 1;
+        return err;
+    }
+    _recalculate = false;
+
+    // fall back to neutral data if no remote is valid
+    if (!anyValid)
+    {
+        _mergedData = {};
+        _activeRemote = WJC_ARB_NO_REMOTE;
+        err = 2;
+        return err;
+    }
+
+    // highest priority valid remote. Also provides buttons for merging policies
+    uint8_t topRemote = WJC_ARB_NO_REMOTE;
+    for (uint8_t i = 0; i < _remoteCount; i++)
+    {
+        if (_dataValid[i] && (topRemote == WJC_ARB_NO_REMOTE || _priorities[i] > _priorities[topRemote]))
+        {
+            topRemote = i;
+        }
+    }
+
+    _activeRemote = topRemote;
+
+    if (_policy == WJC_ARB_LAST_ACTIVE)
+    {
+        for (uint8_t i = 0; i < _remoteCount; i++)
+        {
+            if (_dataValid[i] && (long)(_lastChanged_ms[i] - _lastChanged_ms[_activeRemote]) > 0)
+            {
+                _activeRemote = i;
+            }
+        }
+    }
+
+    if (_policy == WJC_ARB_INSTRUCTOR && !_isActive(_lastData[topRemote]))
+    {
+        // instructor is idle. Give control to the highest priority trainee
+        uint8_t traineeRemote = WJC_ARB_NO_REMOTE;
+        for (uint8_t i = 0; i < _remoteCount; i++)
+        {
+            if (i != topRemote && _dataValid[i] && (traineeRemote == WJC_ARB_NO_REMOTE || _priorities[i] > _priorities[traineeRemote]))
+            {
+                traineeRemote = i;
+            }
+        }
+
+        if (traineeRemote != WJC_ARB_NO_REMOTE)
+        {
+            _activeRemote = traineeRemote;
+        }
+    }
+
+    _mergedData = _lastData[_activeRemote];
+
+    if (_policy == WJC_ARB_SUM)
+    {
+        _mergeAxes(false);
+    }
+
+    if (_policy == WJC_ARB_AVERAGE)
+    {
+        _mergeAxes(true);
+    }
+
+    return err;
+}
+
+void WJC_Arbiter::setClock(WJC_Clock_t clock)
+{
+    _clock = clock;
+}
+
+const WJC_Remote_t &WJC_Arbiter::getRemoteData(void)
+{
+    return _mergedData;
+}
+
+uint8_t WJC_Arbiter::getActiveRemote(void)
+{
+    return _activeRemote;
+}
+
+int8_t WJC_Arbiter::getJoystick(uint8_t whichJoystick, uint8_t axis)
+{
+    int8_t val = 0;
+
+    if (whichJoystick == WJC_LEFT_JOYSTICK && axis == WJC_X_AXIS)
+    {
+        val = _mergedData.leftJoystickX;
+    }
+    if (whichJoystick == WJC_LEFT_JOYSTICK && axis == WJC_Y_AXIS)
+    {
+        val = _mergedData.leftJoystickY;
+    }
+    if (whichJoystick == WJC_RIGHT_JOYSTICK && axis == WJC_X_AXIS)
+    {
+        val = _mergedData.rightJoystickX;
+    }
+    if (whichJoystick == WJC_RIGHT_JOYSTICK && axis == WJC_Y_AXIS)
+    {
+        val = _mergedData.rightJoystickY;
+    }
+
+    return val;
+}
+
+bool WJC_Arbiter::getButtonValue(uint8_t whichGroup, uint8_t whichButton)
+{
+    const WJC_Btn_Grp_t *group = nullptr;
+
+    if (whichGroup == WJC_BTN_GROUP_A)
+    {
+        group = &_mergedData.btnGroupA;
+    }
+
+    if (whichGroup == WJC_BTN_GROUP_B)
+    {
+        group = &_mergedData.btnGroupB;
+    }
+
+    if (group == nullptr)
+    {
+        return false;
+    }
+
+    if (whichButton == WJC_BTN_1)
+    {
+        return group->button1;
+    }
+
+    if (whichButton == WJC_BTN_2)
+    {
+        return group->button2;
+    }
+
+    if (whichButton == WJC_BTN_3)
+    {
+        return group->button3;
+    }
+
+    return false;
+}
+
+bool WJC_Arbiter::_isActive(const WJC_Remote_t &data)
+{
+    if (abs(data.leftJoystickX) > _instructorDeadband || abs(data.leftJoystickY) > _instructorDeadband)
+    {
+        return true;
+    }
+
+    if (abs(data.rightJoystickX) > _instructorDeadband || abs(data.rightJoystickY) > _instructorDeadband)
+    {
+        return true;
+    }
+
+    // in single-selection mode a button always stays selected, so only multi-selection groups count
+    if ((data.btnGroupA.mode && data.btnGroupA.value != 0) || (data.btnGroupB.mode && data.btnGroupB.value != 0))
+    {
+        return true;
+    }
+
+    return false;
+}
+
+void WJC_Arbiter::_mergeAxes(bool average)
+{
+    int16_t leftX = 0;
+    int16_t leftY = 0;
+    int16_t rightX = 0;
+    int16_t rightY = 0;
+    uint8_t validCount = 0;
+
+    for (uint8_t i = 0; i < _remoteCount; i++)
+    {
+        if (_dataValid[i])
+        {
+            leftX += _lastData[i].leftJoystickX;
+            leftY += _lastData[i].leftJoystickY;
+            rightX += _lastData[i].rightJoystickX;
+            rightY += _lastData[i].rightJoystickY;
+            validCount++;
+        }
+    }
+
+    if (average)
+    {
+        leftX /= validCount;
+        leftY /= validCount;
+        rightX /= validCount;
+        rightY /= validCount;
+    }
+
+    _mergedData.leftJoystickX = (int8_t)constrain(leftX, -100, 100);
+    _mergedData.leftJoystickY = (int8_t)constrain(leftY, -100, 100);
+    _mergedData.rightJoystickX = (int8_t)constrain(rightX, -100, 100);
+    _mergedData.rightJoystickY = (int8_t)constrain(rightY, -100, 100);
+}
+
+unsigned long WJC_Arbiter::_now(void)
+{
+    return (_clock != nullptr) ? _clock() : millis();
+}
@@ -0,0 +1,202 @@
+/**
+ * @file WJC_Arbiter.h
+ *
+ * @brief merge several "WiFi Joystick Controller" remotes into a single controller state
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_ARBITER_H__
+#define __SRQ_WJC_ARBITER_H__
+
+#include "WiFi_Joystick_Controller.h"
+
+// maximum number of remotes an arbiter can merge
+constexpr uint8_t WJC_ARB_MAX_REMOTES = 4;
+
+// arbitration policies
+constexpr uint8_t WJC_ARB_PRIORITY = 1;    // highest priority remote with valid data takes over
+constexpr uint8_t WJC_ARB_LAST_ACTIVE = 2; // remote with the most recent input change wins
+constexpr uint8_t WJC_ARB_INSTRUCTOR = 3;  // highest priority remote overrides others while its inputs are active
+constexpr uint8_t WJC_ARB_SUM = 4;         // joystick axes of all valid remotes summed and clamped
+constexpr uint8_t WJC_ARB_AVERAGE = 5;     // joystick axes of all valid remotes averaged
+
+// returned by getActiveRemote() if no remote is in control
+constexpr uint8_t WJC_ARB_NO_REMOTE = 0xFF;
+
+class WJC_Arbiter
+{
+public:
+    /**
+     * @fn WJC_Arbiter
+     * @brief constructor
+     * @param policy arbitration policy
+     * @n WJC_ARB_PRIORITY highest priority remote with valid data takes over
+     * @n WJC_ARB_LAST_ACTIVE remote with the most recent input change wins
+     * @n WJC_ARB_INSTRUCTOR highest priority remote overrides others while its joysticks or buttons are active
+     * @n WJC_ARB_SUM joystick axes of all valid remotes summed and clamped to (-100) - 100
+     * @n WJC_ARB_AVERAGE joystick axes of all valid remotes averaged
+     */
+    WJC_Arbiter(uint8_t policy);
+
+    /**
+     * @fn addRemote
+     * @brief add a remote to the arbiter
+     * @param remote initialized library instance
+     * @param priority priority of the remote. Higher value wins
+     * @return status
+     * @retval 0 remote added
+     * @retval 1 remote is not valid
+     * @retval 2 no free slot left (see WJC_ARB_MAX_REMOTES)
+     */
+    uint8_t addRemote(WiFi_Joystick_Controller *remote, uint8_t priority);
+
+    /**
+     * @fn setPolicy
+     * @brief change the arbitration policy. Merged data will be recalculated in next update()
+     * @param policy arbitration policy (see constructor)
+     */
+    void setPolicy(uint8_t policy);
+
+    /**
+     * @fn setInstructorDeadband
+     * @brief set the joystick deflection needed for the instructor to override. Default deadband is 10
+     * @param deadband joystick deflection (0 - 100)
+     */
+    void setInstructorDeadband(uint8_t deadband);
+
+    /**
+     * @fn setClock
+     * @brief replace millis() as the time source. Use the same clock as the library instances
+     * @param clock time source. Pass nullptr to use millis() again
+     */
+    void setClock(WJC_Clock_t clock);
+
+    /**
+     * @fn update
+     * @brief merge remote data. Recalculates only if a remote applied a new frame or its data valid status changed
+     * @n call after update() of every remote
+     * @return update status
+     * @retval 0 merged data changed
+     * @retval 1 no input changed since last update
+     * @retval 2 no remote has valid data. Merged data is neutral
+     * @n 2 is returned only once, when the last valid remote times out. Later calls return 1 until a remote
+     * @n becomes valid again, so refresh outputs whenever the return value is not 1
+     */
+    uint8_t update(void);
+
+    /**
+     * @fn getRemoteData
+     * @brief get the merged controller data
+     * @return merged controller data
+     */
+    const WJC_Remote_t &getRemoteData(void);
+
+    /**
+     * @fn getActiveRemote
+     * @brief get the remote currently in control
+     * @return index of the remote in the order of addRemote() calls
+     * @retval WJC_ARB_NO_REMOTE no remote in control
+     */
+    uint8_t getActiveRemote(void);
+
+    /**
+     * @fn getJoystick
+     * @brief get merged joystick axis values
+     * @param whichJoystick selected joystick
+     * @n WJC_LEFT_JOYSTICK to select left joystick
+     * @n WJC_RIGHT_JOYSTICK to select joystick
+     * @param axis selected axis
+     * @n WJC_X_AXIS to select x-axis
+     * @n WJC_Y_AXIS to select y-axis
+     * @return value of the selected joystick axis (range is (-100) - 100)
+     */
+    int8_t getJoystick(uint8_t whichJoystick, uint8_t axis);
+
+    /**
+     * @fn getButtonValue
+     * @brief get the merged status of an individual button
+     * @param whichGroup selected button group
+     * @n WJC_BTN_GROUP_A to select button group A
+     * @n WJC_BTN_GROUP_B to select button group B
+     * @param whichButton select button
+     * @n WJC_BTN_1 to select button 1
+     * @n WJC_BTN_2 to select button 2
+     * @n WJC_BTN_3 to select button 3
+     * @return button status
+     * @retval true button is pressed
+     * @retval false button is not pressed
+     */
+    bool getButtonValue(uint8_t whichGroup, uint8_t whichButton);
+
+private:
+    /**
+     * @fn _now
+     * @brief get the current time from the clock
+     * @return current time in milliSeconds
+     */
+    unsigned long _now(void);
+
+    /**
+     * @fn _isActive
+     * @brief check if any joystick or button of the given data is active
+     * @param data controller data
+     * @return true if a joystick is out of the instructor deadband or a button is pressed
+     */
+    bool _isActive(const WJC_Remote_t &data);
+
+    /**
+     * @fn _mergeAxes
+     * @brief sum or average joystick axes of all valid remotes into merged data
+     * @param average average the sum by number of valid remotes
+     */
+    void _mergeAxes(bool average);
+
+    // added remotes and their last seen state
+    WiFi_Joystick_Controller *_remotes[WJC_ARB_MAX_REMOTES];
+    uint8_t _priorities[WJC_ARB_MAX_REMOTES];
+    uint32_t _frameCounts[WJC_ARB_MAX_REMOTES];
+    bool _dataValid[WJC_ARB_MAX_REMOTES];
+    unsigned long _lastChanged_ms[WJC_ARB_MAX_REMOTES];
+    WJC_Remote_t _lastData[WJC_ARB_MAX_REMOTES];
+    uint8_t _remoteCount = 0;
+
+    // merged data
+    WJC_Remote_t _mergedData = {};
+    uint8_t _activeRemote = WJC_ARB_NO_REMOTE;
+
+    // arbitration settings
+    uint8_t _policy;
+    uint8_t _instructorDeadband = 10;
+    bool _recalculate = true;
+
+    // time source. millis() if not set
+    WJC_Clock_t _clock = nullptr;
+};
+
+#endif // __SRQ_WJC_ARBITER_H__
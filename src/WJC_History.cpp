@@ -0,0 +1,315 @@
+/**
+ * @file WJC_History.cpp
+ *
+ * @brief timestamped history of "WiFi Joystick Controller" data with windowed queries
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_History.h"
+
+WJC_History::WJC_History(WJC_History_Entry_t *buffer, uint16_t capacity)
+{
+    _buffer = buffer;
+    _capacity = (buffer != nullptr) ? capacity : 0;
+}
+
+void WJC_History::record(const WJC_Remote_t &data, unsigned long time_ms)
+{
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    _sequence++;
+    __sync_synchronize();
+
+    _buffer[_head].data = data;
+    _buffer[_head].time_ms = time_ms;
+    _head = (_head + 1) % _capacity;
+    if (_count < _capacity)
+    {
+        _count++;
+    }
+
+    __sync_synchronize();
+    _sequence++;
+}
+
+void WJC_History::clear(void)
+{
+    _sequence++;
+    __sync_synchronize();
+
+    _head = 0;
+    _count = 0;
+
+    __sync_synchronize();
+    _sequence++;
+}
+
+void WJC_History::setClock(WJC_Clock_t clock)
+{
+    _clock = clock;
+}
+
+uint16_t WJC_History::getCount(void)
+{
+    return _count;
+}
+
+uint8_t WJC_History::getStateAt(unsigned long time_ms, WJC_Remote_t &data)
+{
+    uint8_t err;
+    uint32_t sequence;
+    uint8_t attempts = 0;
+    bool consistent;
+
+    do
+    {
+        sequence = _sequence;
+        __sync_synchronize();
+
+        // newest frame received at or before the given time
+        err = 1;
+        uint16_t count = _count;
+        for (uint16_t age = 0; age < count; age++)
+        {
+            const WJC_History_Entry_t &entry = _getEntry(age);
+            if ((long)(time_ms - entry.time_ms) >= 0)
+            {
+                data = entry.data;
+                err = WJC_ERR_OK;
+                break;
+            }
+        }
+
+        __sync_synchronize();
+        consistent = (!(sequence & 1) && sequence == _sequence);
+    } while (!consistent && ++attempts < WJC_HISTORY_MAX_ATTEMPTS);
+
+    if (!consistent)
+    {
+        err = 2;
+        return err;
+    }
+
+    return err;
+}
+
+int8_t WJC_History::getJoystickStat(uint8_t whichJoystick, uint8_t axis, unsigned long window_ms, uint8_t whichStat)
+{
+    int8_t minVal;
+    int8_t maxVal;
+    int32_t sumVal;
+    uint16_t samples;
+    uint32_t sequence;
+    uint8_t attempts = 0;
+    bool consistent;
+
+    do
+    {
+        sequence = _sequence;
+        __sync_synchronize();
+
+        unsigned long now_ms = _now();
+        minVal = 100;
+        maxVal = -100;
+        sumVal = 0;
+        samples = 0;
+
+        uint16_t count = _count;
+        for (uint16_t age = 0; age < count; age++)
+        {
+            const WJC_History_Entry_t &entry = _getEntry(age);
+            if (now_ms - entry.time_ms > window_ms)
+            {
+                break;
+            }
+
+            int8_t val = _getAxis(entry.data, whichJoystick, axis);
+            minVal = min(minVal, val);
+            maxVal = max(maxVal, val);
+            sumVal += val;
+            samples++;
+        }
+
+        __sync_synchronize();
+        consistent = (!(sequence & 1) && sequence == _sequence);
+    } while (!consistent && ++attempts < WJC_HISTORY_MAX_ATTEMPTS);
+
+    if (!consistent || samples == 0)
+    {
+        return 0;
+    }
+
+    if (whichStat == WJC_STAT_MIN)
+    {
+        return minVal;
+    }
+
+    if (whichStat == WJC_STAT_MAX)
+    {
+        return maxVal;
+    }
+
+    if (whichStat == WJC_STAT_MEAN)
+    {
+        return (int8_t)(sumVal / samples);
+    }
+
+    return 0;
+}
+
+unsigned long WJC_History::getButtonHoldTime(uint8_t whichGroup, uint8_t whichButton)
+{
+    unsigned long holdTime_ms;
+    uint32_t sequence;
+    uint8_t attempts = 0;
+    bool consistent;
+
+    do
+    {
+        sequence = _sequence;
+        __sync_synchronize();
+
+        holdTime_ms = 0;
+
+        // walk back to the first frame of the current press
+        uint16_t count = _count;
+        uint16_t pressedAge = count;
+        for (uint16_t age = 0; age < count; age++)
+        {
+            if (!_getButton(_getEntry(age).data, whichGroup, whichButton))
+            {
+                break;
+            }
+            pressedAge = age;
+        }
+
+        if (pressedAge < count)
+        {
+            holdTime_ms = _now() - _getEntry(pressedAge).time_ms;
+        }
+
+        __sync_synchronize();
+        consistent = (!(sequence & 1) && sequence == _sequence);
+    } while (!consistent && ++attempts < WJC_HISTORY_MAX_ATTEMPTS);
+
+    if (!consistent)
+    {
+        return 0;
+    }
+
+    return holdTime_ms;
+}
+
+bool WJC_History::getDoublePress(uint8_t whichGroup, uint8_t whichButton, unsigned long window_ms)
+{
+    uint8_t presses;
+    uint32_t sequence;
+    uint8_t attempts = 0;
+    bool consistent;
+
+    do
+    {
+        sequence = _sequence;
+        __sync_synchronize();
+
+        unsigned long now_ms = _now();
+        presses = 0;
+
+        // count released to pressed transitions inside the window
+        uint16_t count = _count;
+        for (uint16_t age = 0; age + 1 < count; age++)
+        {
+            const WJC_History_Entry_t &entry = _getEntry(age);
+            if (now_ms - entry.time_ms > window_ms)
+            {
+                break;
+            }
+
+            if (_getButton(entry.data, whichGroup, whichButton) && !_getButton(_getEntry(age + 1).data, whichGroup, whichButton))
+            {
+                presses++;
+            }
+        }
+
+        __sync_synchronize();
+        consistent = (!(sequence & 1) && sequence == _sequence);
+    } while (!consistent && ++attempts < WJC_HISTORY_MAX_ATTEMPTS);
+
+    if (!consistent)
+    {
+        return false;
+    }
+
+    return presses >= 2;
+}
+
+const WJC_History_Entry_t &WJC_History::_getEntry(uint16_t age)
+{
+    return _buffer[(_head + _capacity - 1 - age) % _capacity];
+}
+
+int8_t WJC_History::_getAxis(const WJC_Remote_t &data, uint8_t whichJoystick, uint8_t axis)
+{
+    if (whichJoystick == WJC_LEFT_JOYSTICK)
+    {
+        return (axis == WJC_X_AXIS) ? data.leftJoystickX : data.leftJoystickY;
+    }
+
+    return (axis == WJC_X_AXIS) ? data.rightJoystickX : data.rightJoystickY;
+}
+
+bool WJC_History::_getButton(const WJC_Remote_t &data, uint8_t whichGroup, uint8_t whichButton)
+{
+    const WJC_Btn_Grp_t &group = (whichGroup == WJC_BTN_GROUP_A) ? data.btnGroupA : data.btnGroupB;
+
+    if (whichButton == WJC_BTN_1)
+    {
+        return group.button1;
+    }
+
+    if (whichButton == WJC_BTN_2)
+    {
+        return group.button2;
+    }
+
+    if (whichButton == WJC_BTN_3)
+    {
+        return group.button3;
+    }
+
+    return false;
+}
+
+unsigned long WJC_History::_now(void)
+{
+    return (_clock != nullptr) ? _clock() : millis();
+}
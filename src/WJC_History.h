@@ -0,0 +1,202 @@
+/**
+ * @file WJC_History.h
+ *
+ * @brief timestamped history of "WiFi Joystick Controller" data with windowed queries
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_HISTORY_H__
+#define __SRQ_WJC_HISTORY_H__
+
+#include "WiFi_Joystick_Controller.h"
+
+// joystick statistic selection
+constexpr uint8_t WJC_STAT_MIN = 1;
+constexpr uint8_t WJC_STAT_MAX = 2;
+constexpr uint8_t WJC_STAT_MEAN = 3;
+
+// number of times a query is read before giving up as busy
+constexpr uint8_t WJC_HISTORY_MAX_ATTEMPTS = 8;
+
+// structure to hold a recorded frame
+typedef struct
+{
+    WJC_Remote_t data;
+    unsigned long time_ms;
+} WJC_History_Entry_t;
+
+// fixed capacity ring of applied frames. The library instance is the only writer. Readers never block it;
+// a query repeats itself if a new frame is recorded while reading, so it can run from a task on the other core.
+// A reader which interrupts record() on the same core (an ISR or a higher priority task) cannot wait for it to finish.
+// It gives up after WJC_HISTORY_MAX_ATTEMPTS reads and gets a busy result
+class WJC_History
+{
+public:
+    /**
+     * @fn WJC_History
+     * @brief constructor
+     * @param buffer entry array owned by the sketch. No memory is allocated by the history
+     * @param capacity number of entries in the array
+     */
+    WJC_History(WJC_History_Entry_t *buffer, uint16_t capacity);
+
+    /**
+     * @fn record
+     * @brief add a frame to the history. Called by the library instance for every applied frame
+     * @param data controller data
+     * @param time_ms receive time of the frame
+     */
+    void record(const WJC_Remote_t &data, unsigned long time_ms);
+
+    /**
+     * @fn clear
+     * @brief remove all recorded frames
+     */
+    void clear(void);
+
+    /**
+     * @fn setClock
+     * @brief replace millis() as the time source. Use the same clock as the library instances
+     * @param clock time source. Pass nullptr to use millis() again
+     */
+    void setClock(WJC_Clock_t clock);
+
+    /**
+     * @fn getCount
+     * @brief get the number of recorded frames
+     * @return recorded frame count (up to capacity)
+     */
+    uint16_t getCount(void);
+
+    /**
+     * @fn getStateAt
+     * @brief get the controller data which was valid at the given time
+     * @param time_ms time to look up
+     * @param data controller data at the given time
+     * @return lookup status
+     * @retval 0 data found
+     * @retval 1 no frame recorded before the given time
+     * @retval 2 busy. A frame was being recorded during every attempt
+     */
+    uint8_t getStateAt(unsigned long time_ms, WJC_Remote_t &data);
+
+    /**
+     * @fn getJoystickStat
+     * @brief get a statistic of a joystick axis over the frames received during the last window_ms
+     * @param whichJoystick selected joystick
+     * @n WJC_LEFT_JOYSTICK to select left joystick
+     * @n WJC_RIGHT_JOYSTICK to select joystick
+     * @param axis selected axis
+     * @n WJC_X_AXIS to select x-axis
+     * @n WJC_Y_AXIS to select y-axis
+     * @param window_ms length of the window in milliSeconds
+     * @param whichStat selected statistic
+     * @n WJC_STAT_MIN to select minimum value
+     * @n WJC_STAT_MAX to select maximum value
+     * @n WJC_STAT_MEAN to select mean value
+     * @return selected statistic. 0 if no frame received during the window or busy
+     */
+    int8_t getJoystickStat(uint8_t whichJoystick, uint8_t axis, unsigned long window_ms, uint8_t whichStat);
+
+    /**
+     * @fn getButtonHoldTime
+     * @brief get how long a button has been pressed continuously
+     * @param whichGroup selected button group
+     * @n WJC_BTN_GROUP_A to select button group A
+     * @n WJC_BTN_GROUP_B to select button group B
+     * @param whichButton select button
+     * @n WJC_BTN_1 to select button 1
+     * @n WJC_BTN_2 to select button 2
+     * @n WJC_BTN_3 to select button 3
+     * @return hold time in milliSeconds. 0 if the button is not pressed in the latest frame or busy
+     */
+    unsigned long getButtonHoldTime(uint8_t whichGroup, uint8_t whichButton);
+
+    /**
+     * @fn getDoublePress
+     * @brief check if a button was pressed twice during the last window_ms
+     * @param whichGroup selected button group (see getButtonHoldTime)
+     * @param whichButton select button (see getButtonHoldTime)
+     * @param window_ms length of the window in milliSeconds
+     * @return true if two or more presses started during the window. false if busy
+     */
+    bool getDoublePress(uint8_t whichGroup, uint8_t whichButton, unsigned long window_ms);
+
+private:
+    /**
+     * @fn _now
+     * @brief get the current time from the clock
+     * @return current time in milliSeconds
+     */
+    unsigned long _now(void);
+
+    /**
+     * @fn _getEntry
+     * @brief get a recorded entry by age
+     * @param age 0 for the newest entry, up to getCount() - 1 for the oldest
+     * @return recorded entry
+     */
+    const WJC_History_Entry_t &_getEntry(uint16_t age);
+
+    /**
+     * @fn _getAxis
+     * @brief get a joystick axis value of the given data
+     * @param data controller data
+     * @param whichJoystick selected joystick
+     * @param axis selected axis
+     * @return value of the selected joystick axis
+     */
+    int8_t _getAxis(const WJC_Remote_t &data, uint8_t whichJoystick, uint8_t axis);
+
+    /**
+     * @fn _getButton
+     * @brief get an individual button status of the given data
+     * @param data controller data
+     * @param whichGroup selected button group
+     * @param whichButton select button
+     * @return button status
+     */
+    bool _getButton(const WJC_Remote_t &data, uint8_t whichGroup, uint8_t whichButton);
+
+    // entry array owned by the sketch
+    WJC_History_Entry_t *_buffer;
+    uint16_t _capacity;
+
+    // next write slot and number of recorded entries
+    volatile uint16_t _head = 0;
+    volatile uint16_t _count = 0;
+
+    // odd while a frame is being recorded. Readers repeat if it was odd or changed during their query
+    volatile uint32_t _sequence = 0;
+
+    // time source. millis() if not set
+    WJC_Clock_t _clock = nullptr;
+};
+
+#endif // __SRQ_WJC_HISTORY_H__
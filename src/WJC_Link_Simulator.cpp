@@ -0,0 +1,229 @@
+/**
+ * @file WJC_Link_Simulator.cpp
+ *
+ * @brief simulated lossy network link for testing "WiFi Joystick Controller" timing without WiFi
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_Link_Simulator.h"
+
+// address reported as the source of simulated packets
+static const IPAddress WJC_LINK_SENDER_IP(10, 0, 0, 2);
+constexpr uint16_t WJC_LINK_SENDER_PORT = 50000;
+
+WJC_Link_Simulator::WJC_Link_Simulator(WJC_Clock_t clock, uint32_t seed)
+{
+    _clock = clock;
+    _randomState = (seed != 0) ? seed : 1;
+
+    for (uint8_t i = 0; i < WJC_LINK_QUEUE_SIZE; i++)
+    {
+        _slotUsed[i] = false;
+    }
+
+    resetStats();
+}
+
+uint8_t WJC_Link_Simulator::begin(uint16_t port)
+{
+    (void)port;
+
+    return WJC_ERR_OK;
+}
+
+uint16_t WJC_Link_Simulator::parsePacket(WJC_Packet_t &packet)
+{
+    // free the slot handed out last time
+    if (_parsedSlot < WJC_LINK_QUEUE_SIZE)
+    {
+        _slotUsed[_parsedSlot] = false;
+        _parsedSlot = WJC_LINK_QUEUE_SIZE;
+    }
+
+    // earliest packet which already arrived
+    unsigned long now_ms = _clock();
+    for (uint8_t i = 0; i < WJC_LINK_QUEUE_SIZE; i++)
+    {
+        if (!_slotUsed[i] || (long)(now_ms - _slotDeliver_ms[i]) < 0)
+        {
+            continue;
+        }
+
+        if (_parsedSlot == WJC_LINK_QUEUE_SIZE || (long)(_slotDeliver_ms[i] - _slotDeliver_ms[_parsedSlot]) < 0)
+        {
+            _parsedSlot = i;
+        }
+    }
+
+    if (_parsedSlot == WJC_LINK_QUEUE_SIZE)
+    {
+        return 0;
+    }
+
+    _stats.delivered++;
+
+    // copies of already delivered or older packets never reach the sketch. Keep them out of the latency
+    if (_slotSequence[_parsedSlot] <= _deliveredSequence)
+    {
+        _stats.superseded++;
+    }
+    else
+    {
+        _deliveredSequence = _slotSequence[_parsedSlot];
+
+        // latency as seen by the library instance, including the time the packet waited for update()
+        uint16_t latency_ms = (uint16_t)min(now_ms - _slotSent_ms[_parsedSlot], 0xFFFFUL);
+        _stats.latencyMin = min(_stats.latencyMin, latency_ms);
+        _stats.latencyMax = max(_stats.latencyMax, latency_ms);
+        _latencySum += latency_ms;
+        _stats.latencyAvg = (uint16_t)(_latencySum / (_stats.delivered - _stats.superseded));
+    }
+
+    packet.data = nullptr;
+    packet.length = _slotLength[_parsedSlot];
+    packet.remoteIP = WJC_LINK_SENDER_IP;
+    packet.remotePort = WJC_LINK_SENDER_PORT;
+
+    return packet.length;
+}
+
+uint16_t WJC_Link_Simulator::readPacket(WJC_Packet_t &packet)
+{
+    packet.data = _slotData[_parsedSlot];
+    packet.length = _slotLength[_parsedSlot];
+
+    return packet.length;
+}
+
+void WJC_Link_Simulator::send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length)
+{
+    (void)remoteIP;
+    (void)remotePort;
+    (void)data;
+    (void)length;
+
+    _stats.replies++;
+}
+
+void WJC_Link_Simulator::setImpairment(uint8_t lossPercent, uint16_t delay_ms, uint16_t jitter_ms, uint8_t duplicatePercent, uint8_t reorderPercent)
+{
+    _lossPercent = lossPercent;
+    _delay_ms = delay_ms;
+    _jitter_ms = jitter_ms;
+    _duplicatePercent = duplicatePercent;
+    _reorderPercent = reorderPercent;
+}
+
+uint8_t WJC_Link_Simulator::transmit(const char *data, uint16_t length)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (length > WJC_MAX_PACKET_SIZE)
+    {
+        err = 1;
+        return err;
+    }
+
+    unsigned long now_ms = _clock();
+    _stats.transmitted++;
+    _transmitSequence++;
+
+    uint8_t copies = 1;
+    if (_random(100) < _duplicatePercent)
+    {
+        copies = 2;
+        _stats.duplicated++;
+    }
+
+    for (uint8_t i = 0; i < copies; i++)
+    {
+        if (_random(100) < _lossPercent)
+        {
+            _stats.lost++;
+            continue;
+        }
+
+        unsigned long deliver_ms = now_ms + _delay_ms + _random(_jitter_ms + 1);
+
+        // hold back long enough for packets sent afterwards to overtake
+        if (_random(100) < _reorderPercent)
+        {
+            deliver_ms += _delay_ms + _jitter_ms + 1;
+            _stats.reordered++;
+        }
+
+        _enqueue(data, length, now_ms, deliver_ms, _transmitSequence);
+    }
+
+    return err;
+}
+
+void WJC_Link_Simulator::getStats(WJC_Link_Stats_t &stats)
+{
+    stats = _stats;
+    if (stats.delivered == stats.superseded)
+    {
+        stats.latencyMin = 0;
+    }
+}
+
+void WJC_Link_Simulator::resetStats(void)
+{
+    _stats = {};
+    _stats.latencyMin = 0xFFFF;
+    _latencySum = 0;
+}
+
+uint32_t WJC_Link_Simulator::_random(uint32_t range)
+{
+    _randomState ^= _randomState << 13;
+    _randomState ^= _randomState >> 17;
+    _randomState ^= _randomState << 5;
+
+    return _randomState % range;
+}
+
+void WJC_Link_Simulator::_enqueue(const char *data, uint16_t length, unsigned long sent_ms, unsigned long deliver_ms, uint32_t sequence)
+{
+    for (uint8_t i = 0; i < WJC_LINK_QUEUE_SIZE; i++)
+    {
+        if (!_slotUsed[i] && i != _parsedSlot)
+        {
+            memcpy(_slotData[i], data, length);
+            _slotLength[i] = length;
+            _slotSent_ms[i] = sent_ms;
+            _slotDeliver_ms[i] = deliver_ms;
+            _slotSequence[i] = sequence;
+            _slotUsed[i] = true;
+            return;
+        }
+    }
+
+    _stats.overflowed++;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file WJC_Link_Simulator.h
+ *
+ * @brief simulated lossy network link for testing "WiFi Joystick Controller" timing without WiFi
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_LINK_SIMULATOR_H__
+#define __SRQ_WJC_LINK_SIMULATOR_H__
+
+#include "WiFi_Joystick_Controller.h"
+
+// number of packets which can be in flight on the simulated link
+constexpr uint8_t WJC_LINK_QUEUE_SIZE = 8;
+
+// structure to hold simulated link statistics
+typedef struct
+{
+    uint32_t transmitted; // packets given to transmit()
+    uint32_t lost;        // packets dropped by the loss setting
+    uint32_t duplicated;  // extra copies added by the duplication setting
+    uint32_t reordered;   // packets held back to arrive after later ones
+    uint32_t overflowed;  // packets dropped because the link queue was full
+    uint32_t delivered;   // packets handed to the library instance
+    uint32_t superseded;  // delivered copies not newer than an already delivered packet (duplicates and overtaken packets)
+    uint32_t replies;     // replies sent back by the library instance
+    uint16_t latencyMin;  // delivery latency in milliSeconds, including the update() polling delay. Superseded copies
+                          // are excluded, since update() drops them as duplicates when the sender uses frame IDs
+    uint16_t latencyAvg;
+    uint16_t latencyMax;
+} WJC_Link_Stats_t;
+
+// transport delivering packets from a simulated sender to the library instance after loss, delay, jitter,
+// duplication and reordering. Driven by a virtual clock, so hours of traffic can run in a moment
+class WJC_Link_Simulator : public WJC_Transport
+{
+public:
+    /**
+     * @fn WJC_Link_Simulator
+     * @brief constructor
+     * @param clock time source shared with the library instance (see WiFi_Joystick_Controller::setClock)
+     * @param seed seed of the random generator. Same seed gives the same impairments
+     */
+    WJC_Link_Simulator(WJC_Clock_t clock, uint32_t seed = 1);
+
+    uint8_t begin(uint16_t port) override;
+    uint16_t parsePacket(WJC_Packet_t &packet) override;
+    uint16_t readPacket(WJC_Packet_t &packet) override;
+    void send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length) override;
+
+    /**
+     * @fn setImpairment
+     * @brief configure the link impairments
+     * @param lossPercent chance of a packet being lost (0 - 100)
+     * @param delay_ms fixed one-way delay in milliSeconds
+     * @param jitter_ms random extra delay in milliSeconds (0 - jitter_ms)
+     * @param duplicatePercent chance of a packet being delivered twice (0 - 100)
+     * @param reorderPercent chance of a packet being held back behind later packets (0 - 100)
+     */
+    void setImpairment(uint8_t lossPercent, uint16_t delay_ms, uint16_t jitter_ms, uint8_t duplicatePercent, uint8_t reorderPercent);
+
+    /**
+     * @fn transmit
+     * @brief send a packet from the simulated sender over the link
+     * @param data packet data
+     * @param length length of the data
+     * @return status
+     * @retval 0 packet is on the link (or lost by the simulation)
+     * @retval 1 packet too long
+     */
+    uint8_t transmit(const char *data, uint16_t length);
+
+    /**
+     * @fn getStats
+     * @brief get link statistics since start or since the last resetStats()
+     * @param stats statistics holding variable
+     */
+    void getStats(WJC_Link_Stats_t &stats);
+
+    /**
+     * @fn resetStats
+     * @brief clear link statistics
+     */
+    void resetStats(void);
+
+private:
+    /**
+     * @fn _random
+     * @brief get the next pseudo random number (xorshift32)
+     * @param range upper bound (excluded)
+     * @return random number (0 - range-1)
+     */
+    uint32_t _random(uint32_t range);
+
+    /**
+     * @fn _enqueue
+     * @brief put a copy of a packet on the link
+     * @param data packet data
+     * @param length length of the data
+     * @param sent_ms time the packet was transmitted
+     * @param deliver_ms time the packet arrives
+     * @param sequence sequence number of the transmitted packet. Copies share it
+     */
+    void _enqueue(const char *data, uint16_t length, unsigned long sent_ms, unsigned long deliver_ms, uint32_t sequence);
+
+    // clock and random generator state
+    WJC_Clock_t _clock;
+    uint32_t _randomState;
+
+    // impairment settings
+    uint8_t _lossPercent = 0;
+    uint16_t _delay_ms = 0;
+    uint16_t _jitter_ms = 0;
+    uint8_t _duplicatePercent = 0;
+    uint8_t _reorderPercent = 0;
+
+    // packets in flight. A slot is free if _slotUsed is false
+    char _slotData[WJC_LINK_QUEUE_SIZE][WJC_MAX_PACKET_SIZE];
+    uint16_t _slotLength[WJC_LINK_QUEUE_SIZE];
+    unsigned long _slotSent_ms[WJC_LINK_QUEUE_SIZE];
+    unsigned long _slotDeliver_ms[WJC_LINK_QUEUE_SIZE];
+    uint32_t _slotSequence[WJC_LINK_QUEUE_SIZE];
+    bool _slotUsed[WJC_LINK_QUEUE_SIZE];
+
+    // slot handed out by parsePacket(). Freed in the next parsePacket() so the view stays valid
+    uint8_t _parsedSlot = WJC_LINK_QUEUE_SIZE;
+
+    // sequence number of the last transmitted packet and of the newest delivered one
+    uint32_t _transmitSequence = 0;
+    uint32_t _deliveredSequence = 0;
+
+    // statistics
+    WJC_Link_Stats_t _stats;
+    uint32_t _latencySum = 0;
+};
+
+#endif // __SRQ_WJC_LINK_SIMULATOR_H__
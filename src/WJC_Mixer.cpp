@@ -0,0 +1,137 @@
+/**
+ * @file WJC_Mixer.cpp
+ *
+ * @brief drive mixers converting "WiFi Joystick Controller" data into actuator outputs
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_Mixer.h"
+
+void WJC_Mixer::setOutputRange(int16_t minOutput, int16_t centerOutput, int16_t maxOutput)
+{
+    _minOutput = minOutput;
+    _centerOutput = centerOutput;
+    _maxOutput = maxOutput;
+}
+
+void WJC_Mixer::mixNeutral(int16_t *outputs)
+{
+    const WJC_Remote_t neutral = {};
+    mix(neutral, outputs);
+}
+
+int16_t WJC_Mixer::_scale(int16_t value)
+{
+    value = constrain(value, -100, 100);
+
+    if (value >= 0)
+    {
+        return _centerOutput + (int16_t)(((int32_t)value * (_maxOutput - _centerOutput)) / 100);
+    }
+
+    return _centerOutput + (int16_t)(((int32_t)value * (_centerOutput - _minOutput)) / 100);
+}
+
+WJC_Arcade_Mixer::WJC_Arcade_Mixer(uint8_t whichJoystick)
+{
+    _joystick = whichJoystick;
+}
+
+uint8_t WJC_Arcade_Mixer::getOutputCount(void)
+{
+    return 2;
+}
+
+void WJC_Arcade_Mixer::mix(const WJC_Remote_t &data, int16_t *outputs)
+{
+    int16_t throttle = (_joystick == WJC_RIGHT_JOYSTICK) ? data.rightJoystickY : data.leftJoystickY;
+    int16_t steering = (_joystick == WJC_RIGHT_JOYSTICK) ? data.rightJoystickX : data.leftJoystickX;
+
+    outputs[WJC_MIX_LEFT_MOTOR] = _scale(throttle + steering);
+    outputs[WJC_MIX_RIGHT_MOTOR] = _scale(throttle - steering);
+}
+
+uint8_t WJC_Tank_Mixer::getOutputCount(void)
+{
+    return 2;
+}
+
+void WJC_Tank_Mixer::mix(const WJC_Remote_t &data, int16_t *outputs)
+{
+    outputs[WJC_MIX_LEFT_MOTOR] = _scale(data.leftJoystickY);
+    outputs[WJC_MIX_RIGHT_MOTOR] = _scale(data.rightJoystickY);
+}
+
+uint8_t WJC_Mecanum_Mixer::getOutputCount(void)
+{
+    return 4;
+}
+
+void WJC_Mecanum_Mixer::mix(const WJC_Remote_t &data, int16_t *outputs)
+{
+    int16_t forward = data.leftJoystickY;
+    int16_t strafe = data.leftJoystickX;
+    int16_t rotate = data.rightJoystickX;
+
+    int16_t wheels[4];
+    wheels[WJC_MIX_FRONT_LEFT] = forward + strafe + rotate;
+    wheels[WJC_MIX_FRONT_RIGHT] = forward - strafe - rotate;
+    wheels[WJC_MIX_REAR_LEFT] = forward - strafe + rotate;
+    wheels[WJC_MIX_REAR_RIGHT] = forward + strafe - rotate;
+
+    // scale all wheels down together to keep the direction if any wheel saturates
+    int16_t peak = 100;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        peak = max(peak, (int16_t)abs(wheels[i]));
+    }
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        outputs[i] = _scale((int16_t)(((int32_t)wheels[i] * 100) / peak));
+    }
+}
+
+WJC_Servo_Mixer::WJC_Servo_Mixer(void)
+{
+    setOutputRange(1000, 1500, 2000);
+}
+
+uint8_t WJC_Servo_Mixer::getOutputCount(void)
+{
+    return 4;
+}
+
+void WJC_Servo_Mixer::mix(const WJC_Remote_t &data, int16_t *outputs)
+{
+    outputs[WJC_MIX_LEFT_X] = _scale(data.leftJoystickX);
+    outputs[WJC_MIX_LEFT_Y] = _scale(data.leftJoystickY);
+    outputs[WJC_MIX_RIGHT_X] = _scale(data.rightJoystickX);
+    outputs[WJC_MIX_RIGHT_Y] = _scale(data.rightJoystickY);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file WJC_Mixer.h
+ *
+ * @brief drive mixers converting "WiFi Joystick Controller" data into actuator outputs
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_MIXER_H__
+#define __SRQ_WJC_MIXER_H__
+
+#include "WiFi_Joystick_Controller.h"
+
+// arcade and tank mixer output selection
+constexpr uint8_t WJC_MIX_LEFT_MOTOR = 0;
+constexpr uint8_t WJC_MIX_RIGHT_MOTOR = 1;
+
+// mecanum mixer output selection
+constexpr uint8_t WJC_MIX_FRONT_LEFT = 0;
+constexpr uint8_t WJC_MIX_FRONT_RIGHT = 1;
+constexpr uint8_t WJC_MIX_REAR_LEFT = 2;
+constexpr uint8_t WJC_MIX_REAR_RIGHT = 3;
+
+// servo mixer output selection
+constexpr uint8_t WJC_MIX_LEFT_X = 0;
+constexpr uint8_t WJC_MIX_LEFT_Y = 1;
+constexpr uint8_t WJC_MIX_RIGHT_X = 2;
+constexpr uint8_t WJC_MIX_RIGHT_Y = 3;
+
+// base class of the mixers. Topology is selected by the mixer class in use, update() calls it through mix()
+class WJC_Mixer
+{
+public:
+    /**
+     * @fn getOutputCount
+     * @brief get the number of outputs written by mix(). Output array must have at least this many elements
+     * @return number of outputs
+     */
+    virtual uint8_t getOutputCount(void) = 0;
+
+    /**
+     * @fn mix
+     * @brief convert controller data into actuator outputs using integer math only
+     * @param data controller data
+     * @param outputs output array
+     */
+    virtual void mix(const WJC_Remote_t &data, int16_t *outputs) = 0;
+
+    /**
+     * @fn mixNeutral
+     * @brief write the outputs for centered joysticks (stopped motors, centered servos). Can use as a failsafe
+     * @param outputs output array
+     */
+    void mixNeutral(int16_t *outputs);
+
+    /**
+     * @fn setOutputRange
+     * @brief set the output range. Joystick value (-100) maps to minOutput, 0 to centerOutput and 100 to maxOutput
+     * @n default range is (-255) - 255 for motor mixers and 1000 - 2000 (microSeconds) for the servo mixer
+     * @param minOutput output for full negative deflection
+     * @param centerOutput output for the neutral position
+     * @param maxOutput output for full positive deflection
+     */
+    void setOutputRange(int16_t minOutput, int16_t centerOutput, int16_t maxOutput);
+
+protected:
+    /**
+     * @fn _scale
+     * @brief scale a mixed value into the output range
+     * @param value mixed value (range is (-100) - 100)
+     * @return output value
+     */
+    int16_t _scale(int16_t value);
+
+    // output range
+    int16_t _minOutput = -255;
+    int16_t _centerOutput = 0;
+    int16_t _maxOutput = 255;
+};
+
+// single joystick differential drive. Y axis is throttle, X axis is steering
+class WJC_Arcade_Mixer : public WJC_Mixer
+{
+public:
+    /**
+     * @fn WJC_Arcade_Mixer
+     * @brief constructor
+     * @param whichJoystick joystick used to drive
+     * @n WJC_LEFT_JOYSTICK to select left joystick
+     * @n WJC_RIGHT_JOYSTICK to select joystick
+     */
+    WJC_Arcade_Mixer(uint8_t whichJoystick = WJC_LEFT_JOYSTICK);
+
+    uint8_t getOutputCount(void) override;
+    void mix(const WJC_Remote_t &data, int16_t *outputs) override;
+
+private:
+    uint8_t _joystick;
+};
+
+// two joystick differential drive. Left Y axis drives left motor, right Y axis drives right motor
+class WJC_Tank_Mixer : public WJC_Mixer
+{
+public:
+    uint8_t getOutputCount(void) override;
+    void mix(const WJC_Remote_t &data, int16_t *outputs) override;
+};
+
+// four wheel mecanum drive. Left joystick translates, right joystick X axis rotates
+class WJC_Mecanum_Mixer : public WJC_Mixer
+{
+public:
+    uint8_t getOutputCount(void) override;
+    void mix(const WJC_Remote_t &data, int16_t *outputs) override;
+};
+
+// direct mapping of each joystick axis to a servo pulse width
+class WJC_Servo_Mixer : public WJC_Mixer
+{
+public:
+    /**
+     * @fn WJC_Servo_Mixer
+     * @brief constructor. Sets the output range to 1000 - 2000 microSeconds
+     */
+    WJC_Servo_Mixer(void);
+
+    uint8_t getOutputCount(void) override;
+    void mix(const WJC_Remote_t &data, int16_t *outputs) override;
+};
+
+#endif // __SRQ_WJC_MIXER_H__
@@ -0,0 +1,266 @@
+/**
+ * @file WJC_Profile_Store.cpp
+ *
+ * @brief storage of the network profile used by WiFi_Joystick_Controller::initFromProfile()
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_Profile_Store.h"
+#include "WiFi_Joystick_Controller.h"
+
+uint8_t WJC_Memory_Profile_Store::load(WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (!_stored)
+    {
+        err = 1;
+        return err;
+    }
+
+    memcpy(&profile, &_profile, sizeof(WJC_Profile_t));
+
+    return err;
+}
+
+uint8_t WJC_Memory_Profile_Store::save(const WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    memcpy(&_profile, &profile, sizeof(WJC_Profile_t));
+    _stored = true;
+    _saveCount++;
+
+    return err;
+}
+
+void WJC_Memory_Profile_Store::clear(void)
+{
+    _stored = false;
+}
+
+uint32_t WJC_Memory_Profile_Store::getSaveCount(void)
+{
+    return _saveCount;
+}
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+WJC_File_Profile_Store::WJC_File_Profile_Store(fs::FS &fs, const char *path) : _fs(fs), _path(path)
+{
+}
+
+uint8_t WJC_File_Profile_Store::load(WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (!_fs.exists(_path))
+    {
+        err = 1;
+        return err;
+    }
+
+    fs::File file = _fs.open(_path, "r");
+    if (!file)
+    {
+        err = 1;
+        return err;
+    }
+
+    size_t length = file.read((uint8_t *)&profile, sizeof(WJC_Profile_t));
+    file.close();
+
+    if (length != sizeof(WJC_Profile_t))
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+uint8_t WJC_File_Profile_Store::save(const WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    fs::File file = _fs.open(_path, "w");
+    if (!file)
+    {
+        err = 1;
+        return err;
+    }
+
+    size_t length = file.write((const uint8_t *)&profile, sizeof(WJC_Profile_t));
+    file.close();
+
+    if (length != sizeof(WJC_Profile_t))
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+void WJC_File_Profile_Store::clear(void)
+{
+    if (_fs.exists(_path))
+    {
+        _fs.remove(_path);
+    }
+}
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+WJC_NVS_Profile_Store::WJC_NVS_Profile_Store(const char *nameSpace, const char *key) : _nameSpace(nameSpace), _key(key)
+{
+}
+
+uint8_t WJC_NVS_Profile_Store::load(WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+    bool loaded = false;
+
+    Preferences preferences;
+    if (preferences.begin(_nameSpace, true))
+    {
+        loaded = (preferences.getBytes(_key, &profile, sizeof(WJC_Profile_t)) == sizeof(WJC_Profile_t));
+        preferences.end();
+    }
+
+    if (!loaded)
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+uint8_t WJC_NVS_Profile_Store::save(const WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+    bool saved = false;
+
+    Preferences preferences;
+    if (preferences.begin(_nameSpace, false))
+    {
+        saved = (preferences.putBytes(_key, &profile, sizeof(WJC_Profile_t)) == sizeof(WJC_Profile_t));
+        preferences.end();
+    }
+
+    if (!saved)
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+void WJC_NVS_Profile_Store::clear(void)
+{
+    Preferences preferences;
+    if (preferences.begin(_nameSpace, false))
+    {
+        preferences.remove(_key);
+        preferences.end();
+    }
+}
+#endif
+
+#if defined(ARDUINO_ARCH_ESP8266)
+WJC_EEPROM_Profile_Store::WJC_EEPROM_Profile_Store(uint16_t address, uint16_t eepromSize) : _address(address), _eepromSize(eepromSize)
+{
+}
+
+uint8_t WJC_EEPROM_Profile_Store::load(WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (_open() != WJC_ERR_OK)
+    {
+        err = 1;
+        return err;
+    }
+
+    EEPROM.get(_address, profile);
+
+    return err;
+}
+
+uint8_t WJC_EEPROM_Profile_Store::save(const WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (_open() != WJC_ERR_OK)
+    {
+        err = 1;
+        return err;
+    }
+
+    EEPROM.put(_address, profile);
+    if (!EEPROM.commit())
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+void WJC_EEPROM_Profile_Store::clear(void)
+{
+    if (_open() != WJC_ERR_OK)
+    {
+        return;
+    }
+
+    EEPROM.write(_address, 0); // breaks the magic value
+    EEPROM.commit();
+}
+
+uint8_t WJC_EEPROM_Profile_Store::_open(void)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    // begin() again would reload the buffer and drop the sketch's uncommitted writes
+    if (EEPROM.length() == 0)
+    {
+        EEPROM.begin(_eepromSize);
+    }
+
+    if ((size_t)_address + sizeof(WJC_Profile_t) > EEPROM.length())
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+#endif
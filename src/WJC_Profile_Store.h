@@ -0,0 +1,208 @@
+/**
+ * @file WJC_Profile_Store.h
+ *
+ * @brief storage of the network profile used by WiFi_Joystick_Controller::initFromProfile()
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_PROFILE_STORE_H__
+#define __SRQ_WJC_PROFILE_STORE_H__
+
+#include <Arduino.h>
+
+// non-volatile storage libraries
+#if defined(ARDUINO_ARCH_ESP32)
+#include <FS.h>
+#include <Preferences.h>
+#elif defined(ARDUINO_ARCH_ESP8266)
+#include <FS.h>
+#include <EEPROM.h>
+#else
+// TODO: reserved for future
+#endif
+
+// stored network profile validation
+constexpr uint32_t WJC_PROFILE_MAGIC = 0x574A4350; // "WJCP"
+constexpr uint8_t WJC_PROFILE_VERSION = 2;
+
+// IP configuration of a stored network profile
+constexpr uint8_t WJC_PROFILE_DHCP = 0;   // address from DHCP. Only the channel and BSSID are reused
+constexpr uint8_t WJC_PROFILE_STATIC = 1; // static IP configuration given to init()
+
+// structure to hold a stored network profile
+typedef struct
+{
+    uint32_t magic;
+    uint8_t version;
+    uint8_t ipMode;
+    char ssid[33];
+    uint8_t bssid[6];
+    int32_t channel;
+    uint32_t localIP;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t primaryDNS;
+    uint32_t secondaryDNS;
+    uint16_t port;
+    uint16_t checksum;
+} WJC_Profile_t;
+
+// base class of the profile stores. Stores keep the profile as raw bytes. It is validated by the library instance
+class WJC_Profile_Store
+{
+public:
+    /**
+     * @fn load
+     * @brief read the stored profile
+     * @param profile profile holding variable
+     * @return load status
+     * @retval 0 profile read
+     * @retval 1 nothing stored or cannot read
+     */
+    virtual uint8_t load(WJC_Profile_t &profile) = 0;
+
+    /**
+     * @fn save
+     * @brief store the profile, replacing any earlier one
+     * @param profile profile to store
+     * @return save status
+     * @retval 0 profile stored
+     * @retval 1 cannot store
+     */
+    virtual uint8_t save(const WJC_Profile_t &profile) = 0;
+
+    /**
+     * @fn clear
+     * @brief erase the stored profile
+     */
+    virtual void clear(void) = 0;
+};
+
+// profile kept in RAM. Lost on reset. Useful to try the connection paths without touching flash
+class WJC_Memory_Profile_Store : public WJC_Profile_Store
+{
+public:
+    uint8_t load(WJC_Profile_t &profile) override;
+    uint8_t save(const WJC_Profile_t &profile) override;
+    void clear(void) override;
+
+    /**
+     * @fn getSaveCount
+     * @brief get the number of profiles stored since start
+     * @return save count
+     */
+    uint32_t getSaveCount(void);
+
+private:
+    WJC_Profile_t _profile;
+    bool _stored = false;
+    uint32_t _saveCount = 0;
+};
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+// profile kept in a file. The file system must be mounted before use (e.g. LittleFS.begin())
+class WJC_File_Profile_Store : public WJC_Profile_Store
+{
+public:
+    /**
+     * @fn WJC_File_Profile_Store
+     * @brief constructor
+     * @param fs mounted file system (e.g. LittleFS, SPIFFS)
+     * @param path file path of the profile
+     */
+    WJC_File_Profile_Store(fs::FS &fs, const char *path);
+
+    uint8_t load(WJC_Profile_t &profile) override;
+    uint8_t save(const WJC_Profile_t &profile) override;
+    void clear(void) override;
+
+private:
+    fs::FS &_fs;
+    const char *_path;
+};
+#endif
+
+#if defined(ARDUINO_ARCH_ESP32)
+// profile kept in NVS using Preferences
+class WJC_NVS_Profile_Store : public WJC_Profile_Store
+{
+public:
+    /**
+     * @fn WJC_NVS_Profile_Store
+     * @brief constructor
+     * @param nameSpace NVS namespace of the profile (15 characters max)
+     * @param key NVS key of the profile (15 characters max)
+     */
+    WJC_NVS_Profile_Store(const char *nameSpace = "wjc", const char *key = "profile");
+
+    uint8_t load(WJC_Profile_t &profile) override;
+    uint8_t save(const WJC_Profile_t &profile) override;
+    void clear(void) override;
+
+private:
+    const char *_nameSpace;
+    const char *_key;
+};
+#endif
+
+#if defined(ARDUINO_ARCH_ESP8266)
+// profile kept in emulated EEPROM, sizeof(WJC_Profile_t) bytes starting from the given address
+// the EEPROM buffer is shared with the sketch. It is opened with EEPROM.begin() only if the sketch has not opened it
+// and is never closed. Saving calls EEPROM.commit(), which also writes the sketch's pending changes
+class WJC_EEPROM_Profile_Store : public WJC_Profile_Store
+{
+public:
+    /**
+     * @fn WJC_EEPROM_Profile_Store
+     * @brief constructor
+     * @param address first EEPROM address of the profile. Keep it clear of the sketch's own EEPROM data
+     * @param eepromSize EEPROM size used if the store opens EEPROM. Use the size the sketch gives to EEPROM.begin()
+     */
+    WJC_EEPROM_Profile_Store(uint16_t address, uint16_t eepromSize);
+
+    uint8_t load(WJC_Profile_t &profile) override;
+    uint8_t save(const WJC_Profile_t &profile) override;
+    void clear(void) override;
+
+private:
+    /**
+     * @fn _open
+     * @brief open EEPROM if the sketch has not opened it yet and check that the profile fits
+     * @return status
+     * @retval 0 profile fits in the open EEPROM
+     * @retval 1 profile does not fit in the open EEPROM
+     */
+    uint8_t _open(void);
+
+    uint16_t _address;
+    uint16_t _eepromSize;
+};
+#endif
+
+#endif // __SRQ_WJC_PROFILE_STORE_H__
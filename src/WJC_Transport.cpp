@@ -0,0 +1,297 @@
+/**
+ * @file WJC_Transport.cpp
+ *
+ * @brief transport layer carrying "WiFi Joystick Controller" data packets
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "WJC_Transport.h"
+#include "WiFi_Joystick_Controller.h"
+
+uint8_t WJC_UDP_Transport::begin(uint16_t port)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (!(_UDP.begin(port)))
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+uint16_t WJC_UDP_Transport::parsePacket(WJC_Packet_t &packet)
+{
+    uint16_t pktSize = _UDP.parsePacket();
+    if (pktSize)
+    {
+        packet.data = nullptr;
+        packet.length = pktSize;
+        packet.remoteIP = _UDP.remoteIP();
+        packet.remotePort = _UDP.remotePort();
+    }
+
+    return pktSize;
+}
+
+uint16_t WJC_UDP_Transport::readPacket(WJC_Packet_t &packet)
+{
+    packet.data = _buffer;
+    packet.length = _UDP.read(_buffer, WJC_MAX_PACKET_SIZE);
+
+    return packet.length;
+}
+
+void WJC_UDP_Transport::send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length)
+{
+    _UDP.beginPacket(remoteIP, remotePort);
+    _UDP.write(data, length);
+    _UDP.endPacket();
+}
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+WJC_TCP_Transport::WJC_TCP_Transport(uint16_t port) : _server(port)
+{
+}
+
+uint8_t WJC_TCP_Transport::begin(uint16_t port)
+{
+    _server.begin(port);
+    _server.setNoDelay(true);
+
+    return WJC_ERR_OK;
+}
+
+uint16_t WJC_TCP_Transport::parsePacket(WJC_Packet_t &packet)
+{
+    // consume the frame handed out last time, read or not
+    _readPos += _parsedLength;
+    _parsedLength = 0;
+
+    // read from the socket only if no complete frame left from the last read
+    for (uint8_t attempt = 0; attempt < 2; attempt++)
+    {
+        uint16_t buffered = _writePos - _readPos;
+        if (buffered >= 2)
+        {
+            uint16_t frameLength = ((uint8_t)_buffer[_readPos] << 8) | (uint8_t)_buffer[_readPos + 1];
+
+            // frame can never fit. Stream cannot be resynchronized
+            if (frameLength == 0 || frameLength > WJC_MAX_PACKET_SIZE)
+            {
+                _disconnect();
+                return 0;
+            }
+
+            if (buffered >= frameLength + 2)
+            {
+                packet.data = nullptr;
+                packet.length = frameLength;
+                packet.remoteIP = _client.remoteIP();
+                packet.remotePort = _client.remotePort();
+                _parsedLength = frameLength + 2;
+                return frameLength;
+            }
+        }
+
+        if (attempt == 0)
+        {
+            _fillBuffer();
+        }
+    }
+
+    return 0;
+}
+
+uint16_t WJC_TCP_Transport::readPacket(WJC_Packet_t &packet)
+{
+    uint16_t frameLength = ((uint8_t)_buffer[_readPos] << 8) | (uint8_t)_buffer[_readPos + 1];
+
+    packet.data = &_buffer[_readPos + 2];
+    packet.length = frameLength;
+
+    return frameLength;
+}
+
+void WJC_TCP_Transport::send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length)
+{
+    // replies always go to the connected client
+    (void)remoteIP;
+    (void)remotePort;
+
+    if (!_client || !_client.connected() || length > WJC_MAX_PACKET_SIZE)
+    {
+        return;
+    }
+
+    uint8_t frame[WJC_MAX_PACKET_SIZE + 2];
+    frame[0] = (uint8_t)(length >> 8);
+    frame[1] = (uint8_t)(length & 0xFF);
+    memcpy(&frame[2], data, length);
+    _client.write(frame, length + 2);
+}
+
+void WJC_TCP_Transport::_fillBuffer(void)
+{
+    // accept a new client when the current one is gone
+    if (!_client || !_client.connected())
+    {
+        _disconnect();
+        _client = _server.accept();
+        if (!_client)
+        {
+            return;
+        }
+        _client.setNoDelay(true);
+    }
+
+    // move the unconsumed partial frame to the front
+    if (_readPos > 0)
+    {
+        memmove(_buffer, &_buffer[_readPos], _writePos - _readPos);
+        _writePos -= _readPos;
+        _readPos = 0;
+    }
+
+    int available = _client.available();
+    if (available > 0)
+    {
+        uint16_t space = WJC_TCP_BUFFER_SIZE - _writePos;
+        int received = _client.read((uint8_t *)&_buffer[_writePos], min((uint16_t)available, space));
+        if (received > 0)
+        {
+            _writePos += received;
+        }
+    }
+}
+
+void WJC_TCP_Transport::_disconnect(void)
+{
+    if (_client)
+    {
+        _client.stop();
+    }
+    _readPos = 0;
+    _writePos = 0;
+    _parsedLength = 0;
+}
+#endif
+
+uint8_t WJC_Loopback_Transport::begin(uint16_t port)
+{
+    (void)port;
+
+    _queueHead = 0;
+    _queueCount = 0;
+    _headParsed = false;
+
+    return WJC_ERR_OK;
+}
+
+uint16_t WJC_Loopback_Transport::parsePacket(WJC_Packet_t &packet)
+{
+    // drop the packet handed out last time
+    if (_headParsed)
+    {
+        _queueHead = (_queueHead + 1) % WJC_LOOPBACK_QUEUE_SIZE;
+        _queueCount--;
+        _headParsed = false;
+    }
+
+    if (_queueCount == 0)
+    {
+        return 0;
+    }
+
+    packet.data = nullptr;
+    packet.length = _queueLength[_queueHead];
+    packet.remoteIP = _queueIP[_queueHead];
+    packet.remotePort = _queuePort[_queueHead];
+    _headParsed = true;
+
+    return packet.length;
+}
+
+uint16_t WJC_Loopback_Transport::readPacket(WJC_Packet_t &packet)
+{
+    packet.data = _queue[_queueHead];
+    packet.length = _queueLength[_queueHead];
+
+    return packet.length;
+}
+
+void WJC_Loopback_Transport::send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length)
+{
+    (void)remoteIP;
+    (void)remotePort;
+
+    _sentLength = min(length, WJC_MAX_PACKET_SIZE);
+    memcpy(_sent, data, _sentLength);
+    _sentCount++;
+}
+
+uint8_t WJC_Loopback_Transport::inject(const char *data, uint16_t length, IPAddress remoteIP, uint16_t remotePort)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (length > WJC_MAX_PACKET_SIZE)
+    {
+        err = 1;
+        return err;
+    }
+
+    if (_queueCount >= WJC_LOOPBACK_QUEUE_SIZE)
+    {
+        err = 2;
+        return err;
+    }
+
+    uint8_t slot = (_queueHead + _queueCount) % WJC_LOOPBACK_QUEUE_SIZE;
+    memcpy(_queue[slot], data, length);
+    _queueLength[slot] = length;
+    _queueIP[slot] = remoteIP;
+    _queuePort[slot] = remotePort;
+    _queueCount++;
+
+    return err;
+}
+
+uint16_t WJC_Loopback_Transport::getSentPacket(char *buffer, uint16_t size)
+{
+    uint16_t length = min(_sentLength, size);
+    memcpy(buffer, _sent, length);
+
+    return length;
+}
+
+uint32_t WJC_Loopback_Transport::getSentCount(void)
+{
+    return _sentCount;
+}
@@ -0,0 +1,230 @@
+/**
+ * @file WJC_Transport.h
+ *
+ * @brief transport layer carrying "WiFi Joystick Controller" data packets
+ *
+ * @author Manodya Rasanjana <manodya@srqrobotics.com>
+ *
+ * @version 1.0.1
+ *
+ * @date 2026-10-18
+ *
+ * @url https://github.com/srqrobotics/WiFi_Joystick_Controller
+ *
+ * -----
+ *
+ * @copyright Copyright (c) 2023-2024 SRQ Robotics (https://www.srqrobotics.com)
+ *
+ * This file is part of the WiFi_Joystick_Controller Arduino library
+ *
+ * This library is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef __SRQ_WJC_TRANSPORT_H__
+#define __SRQ_WJC_TRANSPORT_H__
+
+#include <Arduino.h>
+
+// WiFi libraries
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#elif defined(ARDUINO_SAMD_MKR1000)
+#include <WiFi101.h>
+#include <WiFiUdp.h>
+#else
+// TODO: reserved for future
+#endif
+
+// largest data packet a transport delivers. The widest packet is a session header (12 bytes) followed by a JSON frame
+// with timestamp tags and a redundant copy of the previous frame, all values at their widest (WJC_MAX_FRAME_SIZE, 292 bytes)
+constexpr uint16_t WJC_MAX_PACKET_SIZE = 320;
+
+// TCP stream buffer. Holds several length-prefixed frames read at once
+constexpr uint16_t WJC_TCP_BUFFER_SIZE = 512;
+
+// number of packets the loopback transport can queue
+constexpr uint8_t WJC_LOOPBACK_QUEUE_SIZE = 4;
+
+// view of a received data packet. Data is owned by the transport and stays valid until the next parsePacket()
+typedef struct
+{
+    char *data;
+    uint16_t length;
+    IPAddress remoteIP;
+    uint16_t remotePort;
+} WJC_Packet_t;
+
+// base class of the transports
+class WJC_Transport
+{
+public:
+    /**
+     * @fn begin
+     * @brief start listening on the given port
+     * @param port local port number
+     * @return initialization status
+     * @retval 0 initialization succeeded
+     * @retval 1 initialization failed
+     */
+    virtual uint8_t begin(uint16_t port) = 0;
+
+    /**
+     * @fn parsePacket
+     * @brief check for the next data packet and fill its source and length. Data is not read yet,
+     * @n so packets can be dropped by their source without any reading
+     * @param packet packet view to fill
+     * @return length of the packet. 0 if no packet available
+     */
+    virtual uint16_t parsePacket(WJC_Packet_t &packet) = 0;
+
+    /**
+     * @fn readPacket
+     * @brief read the packet found by parsePacket() and point the packet view to its data
+     * @param packet packet view to fill
+     * @return number of bytes available in packet.data
+     */
+    virtual uint16_t readPacket(WJC_Packet_t &packet) = 0;
+
+    /**
+     * @fn send
+     * @brief send a data packet
+     * @param remoteIP destination IP address
+     * @param remotePort destination port number
+     * @param data data to send
+     * @param length length of the data
+     */
+    virtual void send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length) = 0;
+};
+
+// one datagram carries one data packet
+class WJC_UDP_Transport : public WJC_Transport
+{
+public:
+    uint8_t begin(uint16_t port) override;
+    uint16_t parsePacket(WJC_Packet_t &packet) override;
+    uint16_t readPacket(WJC_Packet_t &packet) override;
+    void send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length) override;
+
+private:
+    // UDP socket instance
+    WiFiUDP _UDP;
+
+    // receive buffer
+    char _buffer[WJC_MAX_PACKET_SIZE];
+};
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+// stream of data packets, each prefixed with its length as a 2 byte big-endian value
+// a single socket read can deliver several data packets
+class WJC_TCP_Transport : public WJC_Transport
+{
+public:
+    /**
+     * @fn WJC_TCP_Transport
+     * @brief constructor
+     * @param port listening port number. Use the same port number as the library instance
+     */
+    WJC_TCP_Transport(uint16_t port);
+
+    uint8_t begin(uint16_t port) override;
+    uint16_t parsePacket(WJC_Packet_t &packet) override;
+    uint16_t readPacket(WJC_Packet_t &packet) override;
+    void send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length) override;
+
+private:
+    /**
+     * @fn _fillBuffer
+     * @brief accept a new client if needed and read all available bytes into the stream buffer
+     */
+    void _fillBuffer(void);
+
+    /**
+     * @fn _disconnect
+     * @brief drop the client and discard buffered data
+     */
+    void _disconnect(void);
+
+    // TCP server and the connected client
+    WiFiServer _server;
+    WiFiClient _client;
+
+    // stream buffer. Bytes between _readPos and _writePos are not consumed yet
+    char _buffer[WJC_TCP_BUFFER_SIZE];
+    uint16_t _readPos = 0;
+    uint16_t _writePos = 0;
+
+    // frame at _readPos was handed out by parsePacket(). Consumed in the next parsePacket() so the view stays valid
+    uint16_t _parsedLength = 0;
+};
+#endif
+
+// in-memory transport. Packets are injected by the sketch and sent packets are kept for inspection
+class WJC_Loopback_Transport : public WJC_Transport
+{
+public:
+    uint8_t begin(uint16_t port) override;
+    uint16_t parsePacket(WJC_Packet_t &packet) override;
+    uint16_t readPacket(WJC_Packet_t &packet) override;
+    void send(IPAddress remoteIP, uint16_t remotePort, const uint8_t *data, uint16_t length) override;
+
+    /**
+     * @fn inject
+     * @brief queue a data packet as if it was received from the given source
+     * @param data packet data
+     * @param length length of the data
+     * @param remoteIP source IP address
+     * @param remotePort source port number
+     * @return status
+     * @retval 0 packet queued
+     * @retval 1 packet too long
+     * @retval 2 queue is full
+     */
+    uint8_t inject(const char *data, uint16_t length, IPAddress remoteIP, uint16_t remotePort);
+
+    /**
+     * @fn getSentPacket
+     * @brief copy the last sent packet
+     * @param buffer destination buffer
+     * @param size size of the destination buffer
+     * @return length of the copied packet. 0 if nothing sent
+     */
+    uint16_t getSentPacket(char *buffer, uint16_t size);
+
+    /**
+     * @fn getSentCount
+     * @brief get the number of packets sent since start
+     * @return sent packet count
+     */
+    uint32_t getSentCount(void);
+
+private:
+    // received packet queue
+    char _queue[WJC_LOOPBACK_QUEUE_SIZE][WJC_MAX_PACKET_SIZE];
+    uint16_t _queueLength[WJC_LOOPBACK_QUEUE_SIZE];
+    IPAddress _queueIP[WJC_LOOPBACK_QUEUE_SIZE];
+    uint16_t _queuePort[WJC_LOOPBACK_QUEUE_SIZE];
+    uint8_t _queueHead = 0;
+    uint8_t _queueCount = 0;
+
+    // packet at the queue head was handed out by parsePacket(). Dropped in the next parsePacket() so the view stays valid
+    bool _headParsed = false;
+
+    // last sent packet
+    char _sent[WJC_MAX_PACKET_SIZE];
+    uint16_t _sentLength = 0;
+    uint32_t _sentCount = 0;
+};
+
+#endif // __SRQ_WJC_TRANSPORT_H__
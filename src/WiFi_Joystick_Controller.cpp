@@ -32,12 +32,26 @@
  */
 
 #include "WiFi_joystick_controller.h"
+#include "WJC_Mixer.h"
+#include "WJC_History.h"
+
+// random number generator for session challenges
+#if defined(ARDUINO_SAMD_MKR1000)
+#include <ArduinoECCX08.h>
+#endif
 
 bool WiFi_Joystick_Controller::WJC_WIFI_INIT = false;
 
 WiFi_Joystick_Controller::WiFi_Joystick_Controller(uint16_t udpPort)
 {
     _port = udpPort;
+    _transport = &_udpTransport;
+}
+
+WiFi_Joystick_Controller::WiFi_Joystick_Controller(WJC_Transport *transport, uint16_t port)
+{
+    _port = port;
+    _transport = (transport != nullptr) ? transport : &_udpTransport;
 }
 
 uint8_t WiFi_Joystick_Controller::init(bool wifiInitialized)
@@ -56,9 +70,9 @@ uint8_t WiFi_Joystick_Controller::init(bool wifiInitialized)
         return err;
     }
 
-    // enable UDP port and get status
-    uint8_t udpSuccess = _initUDP();
-    if (udpSuccess != WJC_ERR_OK)
+    // enable transport socket and get status
+    uint8_t transportSuccess = _initTransport();
+    if (transportSuccess != WJC_ERR_OK)
     {
         err = 2;
         return err;
@@ -110,9 +124,9 @@ uint8_t WiFi_Joystick_Controller::init(uint8_t mode, const char *ssid, const cha
     // WiFi initialized
     WJC_WIFI_INIT = true;
 
-    // enable UDP port and get status
-    uint8_t udpSuccess = _initUDP();
-    if (udpSuccess != WJC_ERR_OK)
+    // enable transport socket and get status
+    uint8_t transportSuccess = _initTransport();
+    if (transportSuccess != WJC_ERR_OK)
     {
         err = 5;
         return err;
@@ -156,9 +170,11 @@ uint8_t WiFi_Joystick_Controller::init(const char *ssid, const char *password, I
     // WiFi initialized
     WJC_WIFI_INIT = true;
 
-    // enable UDP port and get status
-    uint8_t udpSuccess = _initUDP();
-    if (udpSuccess != WJC_ERR_OK)
+    _saveProfile(WJC_PROFILE_STATIC);
+
+    // enable transport socket and get status
+    uint8_t transportSuccess = _initTransport();
+    if (transportSuccess != WJC_ERR_OK)
     {
         err = 4;
         return err;
@@ -167,11 +183,96 @@ uint8_t WiFi_Joystick_Controller::init(const char *ssid, const char *password, I
     return err;
 }
 
+uint8_t WiFi_Joystick_Controller::initFromProfile(const char *ssid, const char *password)
+{
+    uint8_t err = WJC_ERR_OK;
+    WJC_Profile_t profile;
+
+    _connectPath = WJC_CONNECT_NONE;
+
+    // check if WiFi already enabled using the library
+    if (WJC_WIFI_INIT)
+    {
+        err = 1;
+        return err;
+    }
+
+    // try the stored profile first if it belongs to the same network and port
+    if (_loadProfile(profile) == WJC_ERR_OK && strncmp(profile.ssid, ssid, sizeof(profile.ssid)) == 0 && profile.port == _port)
+    {
+        if (_initFastSTA(profile, password) == WJC_ERR_OK)
+        {
+            _connectPath = WJC_CONNECT_FAST;
+        }
+    }
+    else
+    {
+        // no usable profile. Full connection using DHCP
+        memset(&profile, 0, sizeof(WJC_Profile_t));
+        profile.ipMode = WJC_PROFILE_DHCP;
+    }
+
+    // fall back to a full connection, keeping the IP configuration of the profile
+    if (_connectPath == WJC_CONNECT_NONE)
+    {
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+        WiFi.disconnect();
+#endif
+
+        if (_applyProfileConfig(profile) != WJC_ERR_OK)
+        {
+            err = 2;
+            return err;
+        }
+
+        uint8_t staSucceed = _initSTA(ssid, password);
+        if (staSucceed != WJC_ERR_OK)
+        {
+            err = 2;
+            return err;
+        }
+        _connectPath = WJC_CONNECT_FULL;
+    }
+
+    // WiFi initialized
+    WJC_WIFI_INIT = true;
+
+    _saveProfile(profile.ipMode);
+
+    // enable transport socket and get status
+    uint8_t transportSuccess = _initTransport();
+    if (transportSuccess != WJC_ERR_OK)
+    {
+        err = 3;
+        return err;
+    }
+
+    return err;
+}
+
+uint8_t WiFi_Joystick_Controller::getConnectPath(void)
+{
+    return _connectPath;
+}
+
+void WiFi_Joystick_Controller::setProfileStore(WJC_Profile_Store *store)
+{
+    _profileStore = store;
+}
+
+void WiFi_Joystick_Controller::clearStoredProfile(void)
+{
+    if (_profileStore != nullptr)
+    {
+        _profileStore->clear();
+    }
+}
+
 uint8_t WiFi_Joystick_Controller::update(bool sendValidationMessage)
 {
     uint8_t err = WJC_ERR_OK;
-    const uint8_t bufferSize = 200;
-    char pktBuffer[bufferSize];
+    const size_t jsonSize = JSON_OBJECT_SIZE(WJC_FRAME_MEMBERS) + JSON_OBJECT_SIZE(WJC_PREV_FRAME_MEMBERS);
+    WJC_Packet_t packet;
 
     // check if WiFi enabled previously
     if (!WJC_WIFI_INIT)
@@ -180,51 +281,192 @@ uint8_t WiFi_Joystick_Controller::update(bool sendValidationMessage)
         return err;
     }
 
-    // check if a UDP data packet received and process it if received
-    uint16_t pktSize = _UDP.parsePacket();
+    // failsafe. Mixer outputs return to neutral once when the data times out
+    if (_mixer != nullptr && !_mixerNeutral && getDataValidStatus() != WJC_ERR_OK)
+    {
+        _mixer->mixNeutral(_mixerOutputs);
+        _mixerNeutral = true;
+    }
+
+    // check if a data packet received and process it if received
+    uint16_t pktSize = _transport->parsePacket(packet);
     if (pktSize)
     {
-        uint16_t dataLength = _UDP.read(pktBuffer, bufferSize - 1);
-        pktBuffer[dataLength] = '\0';
+        bool pktRead = false;
 
-        StaticJsonDocument<bufferSize> jsonBuffer;
-        DeserializationError jsonError = deserializeJson(jsonBuffer, pktBuffer);
+        // answer health queries without touching the control data. Session mode only answers authenticated queries
+        uint16_t querySize = _sessionEnabled ? WJC_SESSION_HEADER_SIZE + WJC_STATS_QUERY_SIZE : WJC_STATS_QUERY_SIZE;
+        if (_statsQueryEnabled && pktSize == querySize)
+        {
+            _transport->readPacket(packet);
+            pktRead = true;
 
-        if (!jsonError)
+            if (packet.length == querySize && memcmp(&packet.data[querySize - WJC_STATS_QUERY_SIZE], WJC_STATS_QUERY, WJC_STATS_QUERY_SIZE) == 0 &&
+                (!_sessionEnabled || _checkStatsQuery(packet) == WJC_ERR_OK))
+            {
+                _sendStats(packet.remoteIP, packet.remotePort);
+                err = 7;
+                return err;
+            }
+        }
+
+        // release the session if the pinned controller went silent
+        if (_sessionPinned && (_now() - _sessionLastSeen_ms >= _sessionTimeout_ms))
         {
-            bool dataValid = (bool)jsonBuffer["WJC"]; // validation tag
+            _sessionPinned = false;
+        }
 
-            if (dataValid)
+        // answer challenge requests while no controller is pinned
+        if (_sessionEnabled && _challengeAvailable && !_sessionPinned && pktSize == WJC_SESSION_CHALLENGE_SIZE)
+        {
+            if (!pktRead)
+            {
+                _transport->readPacket(packet);
+                pktRead = true;
+            }
+
+            if (packet.length == WJC_SESSION_CHALLENGE_SIZE && memcmp(packet.data, WJC_SESSION_CHALLENGE, 4) == 0)
+            {
+                _sendChallenge(packet);
+                err = 9;
+                return err;
+            }
+        }
+
+        // drop packets from other hosts without reading them
+        if (_sessionPinned && (packet.remoteIP != _sessionIP || packet.remotePort != _sessionPort))
+        {
+            _sessionRejects++;
+            err = 5;
+            return err;
+        }
+
+        if (!pktRead)
+        {
+            _transport->readPacket(packet);
+        }
+
+        // decode directly from the transport buffer
+        char *payload = packet.data;
+        uint16_t payloadLength = packet.length;
+        if (_sessionEnabled)
+        {
+            uint8_t sessionSucceed = _checkSession(packet);
+
+            // authenticated copies are wasted duplicates, not session rejects
+            if (sessionSucceed == 5)
+            {
+                _duplicateFrames++;
+                err = 6;
+                return err;
+            }
+
+            if (sessionSucceed != WJC_ERR_OK)
+            {
+                _sessionRejects++;
+                err = 5;
+                return err;
+            }
+            payload += WJC_SESSION_HEADER_SIZE;
+            payloadLength -= WJC_SESSION_HEADER_SIZE;
+        }
+
+        // the negotiated sender only gets what it selected. Other senders keep every supported feature
+        bool negotiated = _isNegotiatedSender(packet);
+        uint16_t features = negotiated ? _negotiatedFeatures : _getSupportedFeatures();
+
+        // binary burst frames. JSON packets always start with '{'
+        if (payloadLength > 0 && (uint8_t)payload[0] == WJC_BURST_FRAME)
+        {
+            if (negotiated && (_negotiatedFormat != WJC_FMT_BINARY || !(features & WJC_FEAT_BURST)))
+            {
+                _invalidPackets++;
+                err = 4;
+                return err;
+            }
+
+            err = _decodeBurst((const uint8_t *)payload, payloadLength, features);
+            if (err == WJC_ERR_OK)
             {
-                _wjcData.leftJoystickX = (int8_t)jsonBuffer["jsLx"]; // left joystick X
-                _wjcData.leftJoystickY = (int8_t)jsonBuffer["jsLy"]; // left joystick Y
+                _acceptPacket(packet, sendValidationMessage);
+            }
+            return err;
+        }
+
+        StaticJsonDocument<jsonSize> jsonBuffer;
+        DeserializationError jsonError = deserializeJson(jsonBuffer, payload, payloadLength);
 
-                _wjcData.rightJoystickX = (int8_t)jsonBuffer["jsRx"]; // right joystick X
-                _wjcData.rightJoystickY = (int8_t)jsonBuffer["jsRy"]; // right joystick Y
+        if (!jsonError)
+        {
+            JsonObjectConst frame = jsonBuffer.as<JsonObjectConst>();
+
+            // handshake packets carry no "WJC" tag, so legacy firmware ignores them
+            if (_handleHandshake(frame, packet) == WJC_ERR_OK)
+            {
+                err = 8;
+                return err;
+            }
 
-                _wjcData.btnGroupA.value = (uint8_t)jsonBuffer["bgA"]; // button group A value
-                _wjcData.btnGroupA.mode = (bool)jsonBuffer["bgmA"];    // button group A mode
+            bool dataValid = (bool)frame["WJC"]; // validation tag
 
-                _wjcData.btnGroupB.value = (uint8_t)jsonBuffer["bgB"]; // button group B value
-                _wjcData.btnGroupB.mode = (bool)jsonBuffer["bgmB"];    // button group B mode
+            // JSON data packets are not accepted from a sender which selected another format
+            if (negotiated && _negotiatedFormat != WJC_FMT_JSON)
+            {
+                dataValid = false;
+            }
 
-                _calcBtnValues();
-                _lastUpdated_ms = millis();
+            if (dataValid)
+            {
+                // frame IDs are optional. Legacy senders apply every packet
+                if ((features & WJC_FEAT_FRAME_ID) && frame["fid"].is<uint16_t>())
+                {
+                    uint16_t frameId = frame["fid"];
+
+                    // drop duplicates and late copies of already applied frames
+                    if (_isDuplicateFrame(frameId))
+                    {
+                        err = 6;
+                        return err;
+                    }
+
+                    // fill the lost frame from the redundant copy of the previous frame
+                    JsonObjectConst prevFrame = frame["prv"];
+                    if ((features & WJC_FEAT_REDUNDANT) && _frameIdValid && !prevFrame.isNull() && (uint16_t)(frameId - _lastFrameId) > 1)
+                    {
+                        uint16_t prevFrameId = prevFrame["fid"];
+                        if ((int16_t)(prevFrameId - _lastFrameId) > 0)
+                        {
+                            _decodeFrame(prevFrame);
+                            _recoveredFrames++;
+                        }
+                    }
+
+                    _lastFrameId = frameId;
+                    _frameIdValid = true;
+                }
 
-                if (sendValidationMessage)
+                _decodeFrame(frame);
+                if (features & WJC_FEAT_TIMESTAMP)
+                {
+                    _updateRoundTrip(frame);
+                }
+                else
                 {
-                    sendReply(false);
+                    _echoValid = false;
                 }
+                _acceptPacket(packet, sendValidationMessage);
             }
             // data cannot validated
             else
             {
+                _invalidPackets++;
                 err = 4;
             }
         }
         // cannot deserialize received packet
         else
         {
+            _decodeErrors++;
             err = 3;
         }
     }
@@ -237,6 +479,255 @@ uint8_t WiFi_Joystick_Controller::update(bool sendValidationMessage)
     return err;
 }
 
+const WJC_Remote_t &WiFi_Joystick_Controller::getRemoteData(void)
+{
+    return _wjcData;
+}
+
+uint32_t WiFi_Joystick_Controller::getFrameCount(void)
+{
+    return _frameCount;
+}
+
+void WiFi_Joystick_Controller::setMixer(WJC_Mixer *mixer, int16_t *outputs)
+{
+    _mixer = (outputs != nullptr) ? mixer : nullptr;
+    _mixerOutputs = outputs;
+
+    // start from a safe state until the first packet
+    if (_mixer != nullptr)
+    {
+        _mixer->mixNeutral(_mixerOutputs);
+        _mixerNeutral = true;
+    }
+}
+
+void WiFi_Joystick_Controller::setHistory(WJC_History *history)
+{
+    _history = history;
+}
+
+uint32_t WiFi_Joystick_Controller::getRecoveredFrameCount(void)
+{
+    return _recoveredFrames;
+}
+
+uint32_t WiFi_Joystick_Controller::getDuplicateFrameCount(void)
+{
+    return _duplicateFrames;
+}
+
+void WiFi_Joystick_Controller::getStats(WJC_Stats_t &stats)
+{
+    unsigned long now_ms = _now();
+
+    stats.uptime_ms = now_ms;
+    stats.accepted = _acceptedPackets;
+    stats.decodeErrors = _decodeErrors;
+    stats.invalidPackets = _invalidPackets;
+    stats.sessionRejects = _sessionRejects;
+    stats.duplicates = _duplicateFrames;
+    stats.recovered = _recoveredFrames;
+
+    // rate is stale if no packet closed a window recently
+    stats.packetRate = (now_ms - _rateWindowStart_ms < 2000) ? _packetRate : 0;
+
+    stats.dataAge_ms = now_ms - _lastUpdated_ms;
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    stats.freeHeap = ESP.getFreeHeap();
+#else
+    // TODO: reserved for future
+    stats.freeHeap = 0;
+#endif
+}
+
+void WiFi_Joystick_Controller::setStatsQuery(bool enable)
+{
+    _statsQueryEnabled = enable;
+}
+
+void WiFi_Joystick_Controller::setSampleBuffer(WJC_Sample_t *buffer, uint16_t capacity)
+{
+    _samples = buffer;
+    _sampleCapacity = (buffer != nullptr) ? capacity : 0;
+    _sampleHead = 0;
+    _sampleCount = 0;
+}
+
+uint16_t WiFi_Joystick_Controller::getSampleCount(void)
+{
+    return _sampleCount;
+}
+
+uint8_t WiFi_Joystick_Controller::readSample(WJC_Sample_t &sample)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (_sampleCount == 0)
+    {
+        err = 1;
+        return err;
+    }
+
+    sample = _samples[_sampleHead];
+    _sampleHead = (_sampleHead + 1) % _sampleCapacity;
+    _sampleCount--;
+
+    return err;
+}
+
+void WiFi_Joystick_Controller::setMaxDataRate(uint16_t rate_hz)
+{
+    _maxDataRate_hz = rate_hz;
+}
+
+uint8_t WiFi_Joystick_Controller::getNegotiatedFormat(void)
+{
+    return _negotiatedFormat;
+}
+
+uint16_t WiFi_Joystick_Controller::getNegotiatedFeatures(void)
+{
+    return _negotiatedFeatures;
+}
+
+uint8_t WiFi_Joystick_Controller::setSessionKey(const uint8_t *key)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    _sessionPinned = false;
+    _sessionCounter = 0;
+    _challengeValid = false;
+    _statsQueryCounter = 0;
+
+    if (key == nullptr)
+    {
+        _sessionEnabled = false;
+        return err;
+    }
+
+    memcpy(_sessionKey, key, WJC_SESSION_KEY_SIZE);
+    _sessionEnabled = true;
+
+    // predictable nonces would let packets captured before a reset pin the session again. Fail closed without a generator
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    _challengeAvailable = true;
+#elif defined(ARDUINO_SAMD_MKR1000)
+    // unlocked chips return a fixed test pattern instead of random numbers
+    _challengeAvailable = (ECCX08.begin() && ECCX08.locked());
+#else
+    // TODO: reserved for future
+    _challengeAvailable = false;
+#endif
+
+    if (!_challengeAvailable)
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+void WiFi_Joystick_Controller::setSessionTimeout(uint16_t timeout_ms)
+{
+    _sessionTimeout_ms = timeout_ms;
+}
+
+void WiFi_Joystick_Controller::releaseSession(void)
+{
+    _sessionPinned = false;
+    _sessionCounter = 0;
+    _challengeValid = false;
+}
+
+uint8_t WiFi_Joystick_Controller::getSessionStatus(void)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    if (!_sessionPinned)
+    {
+        err = 1; // no controller pinned
+    }
+
+    return err;
+}
+
+uint64_t WiFi_Joystick_Controller::calcPacketTag(const uint8_t *data, uint16_t length)
+{
+    uint64_t k0 = 0;
+    uint64_t k1 = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        k0 |= (uint64_t)_sessionKey[i] << (8 * i);
+        k1 |= (uint64_t)_sessionKey[i + 8] << (8 * i);
+    }
+
+    uint64_t v0 = k0 ^ 0x736f6d6570736575ULL;
+    uint64_t v1 = k1 ^ 0x646f72616e646f6dULL;
+    uint64_t v2 = k0 ^ 0x6c7967656e657261ULL;
+    uint64_t v3 = k1 ^ 0x7465646279746573ULL;
+
+    auto rotl = [](uint64_t x, uint8_t b) -> uint64_t
+    { return (x << b) | (x >> (64 - b)); };
+
+    auto sipRound = [&](void)
+    {
+        v0 += v1;
+        v1 = rotl(v1, 13);
+        v1 ^= v0;
+        v0 = rotl(v0, 32);
+        v2 += v3;
+        v3 = rotl(v3, 16);
+        v3 ^= v2;
+        v0 += v3;
+        v3 = rotl(v3, 21);
+        v3 ^= v0;
+        v2 += v1;
+        v1 = rotl(v1, 17);
+        v1 ^= v2;
+        v2 = rotl(v2, 32);
+    };
+
+    // compress full 8-byte blocks
+    uint16_t blockEnd = length - (length % 8);
+    for (uint16_t i = 0; i < blockEnd; i += 8)
+    {
+        uint64_t m = 0;
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            m |= (uint64_t)data[i + j] << (8 * j);
+        }
+
+        v3 ^= m;
+        sipRound();
+        sipRound();
+        v0 ^= m;
+    }
+
+    // last block holds the remaining bytes and the message length
+    uint64_t b = (uint64_t)(length & 0xFF) << 56;
+    for (uint8_t j = 0; j < (length % 8); j++)
+    {
+        b |= (uint64_t)data[blockEnd + j] << (8 * j);
+    }
+
+    v3 ^= b;
+    sipRound();
+    sipRound();
+    v0 ^= b;
+
+    // finalization
+    v2 ^= 0xFF;
+    sipRound();
+    sipRound();
+    sipRound();
+    sipRound();
+
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
 void WiFi_Joystick_Controller::setDataValidTimeout(uint16_t timeout_ms)
 {
     _dataValidTime_ms = timeout_ms;
@@ -246,7 +737,7 @@ uint8_t WiFi_Joystick_Controller::getDataValidStatus(void)
 {
     uint8_t err = WJC_ERR_OK;
 
-    if (millis() - _lastUpdated_ms >= _dataValidTime_ms)
+    if (_now() - _lastUpdated_ms >= _dataValidTime_ms)
     {
         err = 1; // timeout occurred
     }
@@ -254,6 +745,16 @@ uint8_t WiFi_Joystick_Controller::getDataValidStatus(void)
     return err;
 }
 
+unsigned long WiFi_Joystick_Controller::getDataAge(void)
+{
+    return _now() - _lastUpdated_ms;
+}
+
+void WiFi_Joystick_Controller::setClock(WJC_Clock_t clock)
+{
+    _clock = clock;
+}
+
 int8_t WiFi_Joystick_Controller::getJoystick(uint8_t whichJoystick, uint8_t axis)
 {
     int8_t val = 0;
@@ -345,24 +846,68 @@ bool WiFi_Joystick_Controller::getButtonValue(uint8_t whichGroup, uint8_t whichB
 
 void WiFi_Joystick_Controller::sendReply(bool sendImmediately)
 {
-    static uint8_t skipper = 0;
     uint8_t replyBuff[] = "{\"valid\"=1}";
 
-    if ((skipper >= 3) || sendImmediately)
+    if ((_replySkipper >= 3) || sendImmediately)
     {
-        _UDP.beginPacket(_UDP.remoteIP(), _UDP.remotePort());
-        _UDP.write(replyBuff, sizeof(replyBuff));
-        _UDP.endPacket();
-        skipper = 0;
+        if (_echoValid)
+        {
+            // echo sender timestamp with the hold time and add own timestamp for the sender to echo back
+            char echoBuff[96];
+            unsigned long now_ms = _now();
+            int echoLength = snprintf(echoBuff, sizeof(echoBuff), "{\"valid\":1,\"fid\":%u,\"ts\":%lu,\"hold\":%lu,\"bts\":%lu}",
+                                      (unsigned int)_echoFrameId, (unsigned long)_echoTimestamp, now_ms - _echoReceived_ms, now_ms);
+            _transport->send(_replyIP, _replyPort, (const uint8_t *)echoBuff, echoLength);
+        }
+        else
+        {
+            _transport->send(_replyIP, _replyPort, replyBuff, sizeof(replyBuff));
+        }
+        _replySkipper = 0;
     }
-    skipper++;
+    _replySkipper++;
 }
 
-IPAddress WiFi_Joystick_Controller::getIpAddress(void)
+uint16_t WiFi_Joystick_Controller::getRoundTripTime(uint8_t whichValue)
 {
-    return _ipAddress;
-}
-
+    if (_rttCount == 0)
+    {
+        return 0;
+    }
+
+    uint16_t minRtt = 0xFFFF;
+    uint16_t maxRtt = 0;
+    uint32_t sumRtt = 0;
+    for (uint8_t i = 0; i < _rttCount; i++)
+    {
+        minRtt = min(minRtt, _rttSamples[i]);
+        maxRtt = max(maxRtt, _rttSamples[i]);
+        sumRtt += _rttSamples[i];
+    }
+
+    if (whichValue == WJC_RTT_MIN)
+    {
+        return minRtt;
+    }
+
+    if (whichValue == WJC_RTT_AVG)
+    {
+        return (uint16_t)(sumRtt / _rttCount);
+    }
+
+    if (whichValue == WJC_RTT_MAX)
+    {
+        return maxRtt;
+    }
+
+    return 0;
+}
+
+IPAddress WiFi_Joystick_Controller::getIpAddress(void)
+{
+    return _ipAddress;
+}
+
 uint16_t WiFi_Joystick_Controller::getPortNumber(void)
 {
     return _port;
@@ -444,7 +989,161 @@ uint8_t WiFi_Joystick_Controller::_initSTA(const char *ssid, const char *passwor
     return err;
 }
 
-uint8_t WiFi_Joystick_Controller::_initUDP(void)
+uint8_t WiFi_Joystick_Controller::_initFastSTA(const WJC_Profile_t &profile, const char *password)
+{
+    uint8_t err = WJC_ERR_OK;
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    WiFi.mode(WIFI_STA);
+
+    // static profiles skip DHCP
+    if (_applyProfileConfig(profile) != WJC_ERR_OK)
+    {
+        err = 1;
+        return err;
+    }
+
+    // known channel and BSSID skip the scan
+    WiFi.begin(profile.ssid, password, profile.channel, profile.bssid);
+
+    // stored network should answer quickly. Give up early and let the full connection take over
+    uint8_t staSucceed = 1;
+    for (uint8_t i = 0; i < 60; i++)
+    {
+        if (WiFi.status() == WL_CONNECTED)
+        {
+            staSucceed = WJC_ERR_OK;
+            break;
+        }
+        delay(50);
+    }
+
+    if (staSucceed != WJC_ERR_OK)
+    {
+        err = 1;
+        return err;
+    }
+
+    _ipAddress = WiFi.localIP();
+#else
+    // TODO: reserved for future
+    (void)profile;
+    (void)password;
+    err = 1;
+#endif
+
+    return err;
+}
+
+uint8_t WiFi_Joystick_Controller::_applyProfileConfig(const WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    bool configured;
+    if (profile.ipMode == WJC_PROFILE_STATIC)
+    {
+        configured = WiFi.config(IPAddress(profile.localIP), IPAddress(profile.gateway), IPAddress(profile.subnet), IPAddress(profile.primaryDNS), IPAddress(profile.secondaryDNS));
+    }
+    else
+    {
+        // all zero configuration returns to DHCP
+        configured = WiFi.config(IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0), IPAddress(0, 0, 0, 0));
+    }
+
+    if (!configured)
+    {
+        err = 1;
+        return err;
+    }
+#elif defined(ARDUINO_SAMD_MKR1000)
+    if (profile.ipMode == WJC_PROFILE_STATIC)
+    {
+        WiFi.config(IPAddress(profile.localIP));
+    }
+#else
+    // TODO: reserved for future
+    (void)profile;
+#endif
+
+    return err;
+}
+
+uint8_t WiFi_Joystick_Controller::_loadProfile(WJC_Profile_t &profile)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    bool loaded = (_profileStore != nullptr && _profileStore->load(profile) == WJC_ERR_OK);
+
+    if (!loaded || profile.magic != WJC_PROFILE_MAGIC || profile.version != WJC_PROFILE_VERSION || profile.checksum != _calcProfileChecksum(profile))
+    {
+        err = 1;
+        return err;
+    }
+
+    return err;
+}
+
+void WiFi_Joystick_Controller::_saveProfile(uint8_t ipMode)
+{
+    if (_profileStore == nullptr)
+    {
+        return;
+    }
+
+#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
+    WJC_Profile_t profile;
+    memset(&profile, 0, sizeof(WJC_Profile_t));
+
+    profile.magic = WJC_PROFILE_MAGIC;
+    profile.version = WJC_PROFILE_VERSION;
+    profile.ipMode = ipMode;
+    strncpy(profile.ssid, WiFi.SSID().c_str(), sizeof(profile.ssid) - 1);
+    memcpy(profile.bssid, WiFi.BSSID(), sizeof(profile.bssid));
+    profile.channel = WiFi.channel();
+
+    // DHCP leases are not reused. Only a static configuration is stored
+    if (ipMode == WJC_PROFILE_STATIC)
+    {
+        profile.localIP = (uint32_t)WiFi.localIP();
+        profile.gateway = (uint32_t)WiFi.gatewayIP();
+        profile.subnet = (uint32_t)WiFi.subnetMask();
+        profile.primaryDNS = (uint32_t)WiFi.dnsIP(0);
+        profile.secondaryDNS = (uint32_t)WiFi.dnsIP(1);
+    }
+    profile.port = _port;
+    profile.checksum = _calcProfileChecksum(profile);
+
+    // skip the flash write if nothing changed
+    WJC_Profile_t storedProfile;
+    if (_loadProfile(storedProfile) == WJC_ERR_OK && memcmp(&storedProfile, &profile, sizeof(WJC_Profile_t)) == 0)
+    {
+        return;
+    }
+
+    _profileStore->save(profile);
+#else
+    // TODO: reserved for future
+    (void)ipMode;
+#endif
+}
+
+uint16_t WiFi_Joystick_Controller::_calcProfileChecksum(const WJC_Profile_t &profile)
+{
+    const uint8_t *data = (const uint8_t *)&profile;
+    uint16_t sum1 = 0;
+    uint16_t sum2 = 0;
+
+    for (size_t i = 0; i < offsetof(WJC_Profile_t, checksum); i++)
+    {
+        sum1 = (sum1 + data[i]) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+
+    return (sum2 << 8) | sum1;
+}
+
+uint8_t WiFi_Joystick_Controller::_initTransport(void)
 {
     uint8_t err = WJC_ERR_OK;
 
@@ -455,16 +1154,445 @@ uint8_t WiFi_Joystick_Controller::_initUDP(void)
         return err;
     }
 
-    // init the UDP socket
-    if (!(_UDP.begin(_port)))
+    // init the transport socket
+    if (_transport->begin(_port) != WJC_ERR_OK)
+    {
+        err = 2;
+        return err;
+    }
+
+    return err;
+}
+
+uint8_t WiFi_Joystick_Controller::_checkSession(const WJC_Packet_t &packet)
+{
+    uint8_t err = WJC_ERR_OK;
+    const uint8_t *data = (const uint8_t *)packet.data;
+    uint16_t length = packet.length;
+
+    // packet must carry the session header and at least one payload byte
+    if (length <= WJC_SESSION_HEADER_SIZE)
+    {
+        err = 1;
+        return err;
+    }
+
+    uint32_t counter = (uint32_t)data[8] | ((uint32_t)data[9] << 8) | ((uint32_t)data[10] << 16) | ((uint32_t)data[11] << 24);
+
+    // a pinned session only accepts newer packets and copies of the last one
+    if (_sessionPinned && counter < _sessionCounter)
+    {
+        err = 3;
+        return err;
+    }
+
+    // an unpinned session only accepts the answer to the last challenge. Checked before the tag, so strangers cost nothing
+    if (!_sessionPinned)
+    {
+        if (!_challengeValid || (_now() - _challengeIssued_ms >= _sessionTimeout_ms) || counter != _challengeNonce ||
+            packet.remoteIP != _challengeIP || packet.remotePort != _challengePort)
+        {
+            err = 4;
+            return err;
+        }
+    }
+
+    uint64_t receivedTag = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        receivedTag |= (uint64_t)data[i] << (8 * i);
+    }
+
+    if (receivedTag != calcPacketTag(data + 8, length - 8))
+    {
+        err = 2;
+        return err;
+    }
+
+    // redundant transmission of the last packet. Not applied again and does not keep the session alive
+    if (_sessionPinned && counter == _sessionCounter)
+    {
+        err = 5;
+        return err;
+    }
+
+    // pin the session to the host that answered the challenge. The challenge cannot be used again
+    if (!_sessionPinned)
+    {
+        _challengeValid = false;
+        _sessionIP = packet.remoteIP;
+        _sessionPort = packet.remotePort;
+        _sessionPinned = true;
+    }
+
+    _sessionCounter = counter;
+    _sessionLastSeen_ms = _now();
+
+    return err;
+}
+
+void WiFi_Joystick_Controller::_sendChallenge(const WJC_Packet_t &packet)
+{
+    uint32_t nonce = 0;
+
+#if defined(ARDUINO_ARCH_ESP32)
+    nonce = esp_random(); // hardware random number generator
+#elif defined(ARDUINO_ARCH_ESP8266)
+    nonce = RANDOM_REG32; // hardware random number generator
+#elif defined(ARDUINO_SAMD_MKR1000)
+    uint8_t randomBytes[4];
+    if (!ECCX08.random(randomBytes, sizeof(randomBytes)))
+    {
+        return; // no challenge. The sender asks again
+    }
+    nonce = (uint32_t)randomBytes[0] | ((uint32_t)randomBytes[1] << 8) | ((uint32_t)randomBytes[2] << 16) | ((uint32_t)randomBytes[3] << 24);
+#else
+    // TODO: reserved for future. Not reached, setSessionKey() leaves challenges disabled without a generator
+    return;
+#endif
+
+    // keep the top bit clear so the counter cannot wrap around within a session
+    _challengeNonce = nonce & 0x7FFFFFFF;
+    _challengeIP = packet.remoteIP;
+    _challengePort = packet.remotePort;
+    _challengeIssued_ms = _now();
+    _challengeValid = true;
+
+    // reply has the same size as the request, so it cannot amplify traffic towards a spoofed source
+    uint8_t replyBuff[WJC_SESSION_CHALLENGE_SIZE];
+    memcpy(replyBuff, WJC_SESSION_CHALLENGE, 4);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        replyBuff[4 + i] = (uint8_t)(_challengeNonce >> (8 * i));
+    }
+
+    _transport->send(packet.remoteIP, packet.remotePort, replyBuff, sizeof(replyBuff));
+}
+
+uint8_t WiFi_Joystick_Controller::_handleHandshake(JsonObjectConst frame, const WJC_Packet_t &packet)
+{
+    uint8_t err = WJC_ERR_OK;
+    char replyBuff[96];
+    int replyLength = 0;
+
+    // hello. Advertise everything supported, whatever the sender announced
+    if (frame["WJCH"].is<uint8_t>())
+    {
+        // negotiated sender starts over. Hello from any other host keeps its selection
+        if (_isNegotiatedSender(packet))
+        {
+            _negotiatedFormat = 0;
+            _negotiatedFeatures = 0;
+        }
+
+        replyLength = snprintf(replyBuff, sizeof(replyBuff), "{\"WJCA\":%u,\"fmt\":%u,\"feat\":%u,\"rate\":%u}",
+                               (unsigned int)WJC_PROTOCOL_VERSION, (unsigned int)(WJC_FMT_JSON | WJC_FMT_BINARY), (unsigned int)_getSupportedFeatures(), (unsigned int)_maxDataRate_hz);
+    }
+    // select. Keep only what is supported and confirm it
+    else if (frame["WJCS"].is<uint8_t>())
+    {
+        uint8_t format = frame["fmt"];
+        uint16_t features = frame["feat"];
+
+        // refuse while another negotiated controller is sending valid data
+        bool otherActive = (_negotiatedFormat != 0 && !_isNegotiatedSender(packet) && _replyIP == _negotiatedIP &&
+                            _replyPort == _negotiatedPort && getDataValidStatus() == WJC_ERR_OK);
+
+        if (otherActive)
+        {
+            replyLength = snprintf(replyBuff, sizeof(replyBuff), "{\"WJCS\":1,\"fmt\":0,\"feat\":0}");
+        }
+        else
+        {
+            _negotiatedFormat = (format == WJC_FMT_JSON || format == WJC_FMT_BINARY) ? format : WJC_FMT_JSON;
+            _negotiatedFeatures = features & _getSupportedFeatures();
+            _negotiatedIP = packet.remoteIP;
+            _negotiatedPort = packet.remotePort;
+
+            replyLength = snprintf(replyBuff, sizeof(replyBuff), "{\"WJCS\":1,\"fmt\":%u,\"feat\":%u}",
+                                   (unsigned int)_negotiatedFormat, (unsigned int)_negotiatedFeatures);
+        }
+    }
+    // not a handshake packet
+    else
+    {
+        err = 1;
+        return err;
+    }
+
+    _transport->send(packet.remoteIP, packet.remotePort, (const uint8_t *)replyBuff, replyLength);
+
+    return err;
+}
+
+bool WiFi_Joystick_Controller::_isNegotiatedSender(const WJC_Packet_t &packet)
+{
+    return (_negotiatedFormat != 0 && packet.remoteIP == _negotiatedIP && packet.remotePort == _negotiatedPort);
+}
+
+uint16_t WiFi_Joystick_Controller::_getSupportedFeatures(void)
+{
+    uint16_t features = WJC_FEAT_FRAME_ID | WJC_FEAT_REDUNDANT | WJC_FEAT_TIMESTAMP | WJC_FEAT_BURST;
+
+    if (_sessionEnabled)
+    {
+        features |= WJC_FEAT_SESSION;
+    }
+
+    if (_statsQueryEnabled)
+    {
+        features |= WJC_FEAT_STATS;
+    }
+
+    return features;
+}
+
+uint8_t WiFi_Joystick_Controller::_checkStatsQuery(const WJC_Packet_t &packet)
+{
+    uint8_t err = WJC_ERR_OK;
+    const uint8_t *data = (const uint8_t *)packet.data;
+
+    // replayed queries would leak the statistics to the replaying host
+    uint32_t counter = (uint32_t)data[8] | ((uint32_t)data[9] << 8) | ((uint32_t)data[10] << 16) | ((uint32_t)data[11] << 24);
+    if (counter <= _statsQueryCounter)
+    {
+        err = 1;
+        return err;
+    }
+
+    uint64_t receivedTag = 0;
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        receivedTag |= (uint64_t)data[i] << (8 * i);
+    }
+
+    if (receivedTag != calcPacketTag(data + 8, packet.length - 8))
     {
         err = 2;
         return err;
     }
 
+    _statsQueryCounter = counter;
+
+    return err;
+}
+
+void WiFi_Joystick_Controller::_sendStats(IPAddress remoteIP, uint16_t remotePort)
+{
+    WJC_Stats_t stats;
+    getStats(stats);
+
+    uint8_t record[WJC_STATS_RECORD_SIZE];
+    uint8_t pos = 0;
+
+    auto put = [&](uint32_t value, uint8_t size)
+    {
+        for (uint8_t i = 0; i < size; i++)
+        {
+            record[pos++] = (uint8_t)(value >> (8 * i));
+        }
+    };
+
+    memcpy(record, "WJSR", 4);
+    pos = 4;
+    put(1, 1); // record version
+    put((getDataValidStatus() == WJC_ERR_OK ? 0x01 : 0x00) | (_sessionPinned ? 0x02 : 0x00), 1);
+    put(stats.uptime_ms, 4);
+    put(stats.accepted, 4);
+    put(stats.decodeErrors, 4);
+    put(stats.invalidPackets, 4);
+    put(stats.sessionRejects, 4);
+    put(stats.duplicates, 4);
+    put(stats.recovered, 4);
+    put(stats.packetRate, 2);
+    put(stats.dataAge_ms, 4);
+    put(stats.freeHeap, 4);
+
+    _transport->send(remoteIP, remotePort, record, pos);
+}
+
+unsigned long WiFi_Joystick_Controller::_now(void)
+{
+    return (_clock != nullptr) ? _clock() : millis();
+}
+
+void WiFi_Joystick_Controller::_decodeFrame(JsonObjectConst frame)
+{
+    _wjcData.leftJoystickX = (int8_t)frame["jsLx"]; // left joystick X
+    _wjcData.leftJoystickY = (int8_t)frame["jsLy"]; // left joystick Y
+
+    _wjcData.rightJoystickX = (int8_t)frame["jsRx"]; // right joystick X
+    _wjcData.rightJoystickY = (int8_t)frame["jsRy"]; // right joystick Y
+
+    _wjcData.btnGroupA.value = (uint8_t)frame["bgA"]; // button group A value
+    _wjcData.btnGroupA.mode = (bool)frame["bgmA"];    // button group A mode
+
+    _wjcData.btnGroupB.value = (uint8_t)frame["bgB"]; // button group B value
+    _wjcData.btnGroupB.mode = (bool)frame["bgmB"];    // button group B mode
+
+    _commitFrame(_now());
+}
+
+uint8_t WiFi_Joystick_Controller::_decodeBurst(const uint8_t *data, uint16_t length, uint16_t features)
+{
+    uint8_t err = WJC_ERR_OK;
+
+    // header and every announced sample must be present
+    uint8_t sampleCount = (length >= WJC_BURST_HEADER_SIZE) ? data[10] : 0;
+    if (sampleCount == 0 || sampleCount > WJC_BURST_MAX_SAMPLES || length < WJC_BURST_HEADER_SIZE + (uint16_t)sampleCount * WJC_BURST_SAMPLE_SIZE)
+    {
+        _decodeErrors++;
+        err = 3;
+        return err;
+    }
+
+    uint16_t frameId = (uint16_t)data[1] | ((uint16_t)data[2] << 8);
+    if (features & WJC_FEAT_FRAME_ID)
+    {
+        if (_isDuplicateFrame(frameId))
+        {
+            err = 6;
+            return err;
+        }
+        _lastFrameId = frameId;
+        _frameIdValid = true;
+    }
+
+    unsigned long received_ms = _now();
+
+    // unpack all samples in a single pass. The last one becomes the latest joystick data
+    const uint8_t *sample = &data[WJC_BURST_HEADER_SIZE];
+    for (uint8_t i = 0; i < sampleCount; i++, sample += WJC_BURST_SAMPLE_SIZE)
+    {
+        uint16_t age_ms = (uint16_t)sample[0] | ((uint16_t)sample[1] << 8);
+
+        _wjcData.leftJoystickX = (int8_t)sample[2];
+        _wjcData.leftJoystickY = (int8_t)sample[3];
+        _wjcData.rightJoystickX = (int8_t)sample[4];
+        _wjcData.rightJoystickY = (int8_t)sample[5];
+
+        if (_sampleCapacity > 0)
+        {
+            WJC_Sample_t &slot = _samples[(_sampleHead + _sampleCount) % _sampleCapacity];
+            slot.time_ms = received_ms - age_ms;
+            slot.leftJoystickX = _wjcData.leftJoystickX;
+            slot.leftJoystickY = _wjcData.leftJoystickY;
+            slot.rightJoystickX = _wjcData.rightJoystickX;
+            slot.rightJoystickY = _wjcData.rightJoystickY;
+
+            // overwrite the oldest sample if the sketch did not keep up
+            if (_sampleCount < _sampleCapacity)
+            {
+                _sampleCount++;
+            }
+            else
+            {
+                _sampleHead = (_sampleHead + 1) % _sampleCapacity;
+            }
+        }
+    }
+
+    _wjcData.btnGroupA.value = data[7];
+    _wjcData.btnGroupB.value = data[8];
+    _wjcData.btnGroupA.mode = (data[9] & 0x01) != 0;
+    _wjcData.btnGroupB.mode = (data[9] & 0x02) != 0;
+
+    // sender timestamp of the last sample is echoed like the "ts" tag
+    _echoValid = (features & WJC_FEAT_TIMESTAMP) != 0;
+    _echoTimestamp = (uint32_t)data[3] | ((uint32_t)data[4] << 8) | ((uint32_t)data[5] << 16) | ((uint32_t)data[6] << 24);
+    _echoFrameId = frameId;
+    _echoReceived_ms = received_ms;
+
+    _commitFrame(received_ms);
+
     return err;
 }
 
+bool WiFi_Joystick_Controller::_isDuplicateFrame(uint16_t frameId)
+{
+    // forget the last frame ID once data timed out, so a restarted sender is accepted
+    if (_now() - _lastUpdated_ms >= _dataValidTime_ms)
+    {
+        _frameIdValid = false;
+    }
+
+    if (_frameIdValid && (int16_t)(frameId - _lastFrameId) <= 0)
+    {
+        _duplicateFrames++;
+        return true;
+    }
+
+    return false;
+}
+
+void WiFi_Joystick_Controller::_commitFrame(unsigned long received_ms)
+{
+    _calcBtnValues();
+    _lastUpdated_ms = received_ms;
+    _frameCount++;
+
+    if (_history != nullptr)
+    {
+        _history->record(_wjcData, _lastUpdated_ms);
+    }
+}
+
+void WiFi_Joystick_Controller::_acceptPacket(const WJC_Packet_t &packet, bool sendValidationMessage)
+{
+    if (_mixer != nullptr)
+    {
+        _mixer->mix(_wjcData, _mixerOutputs);
+        _mixerNeutral = false;
+    }
+
+    // remember the sender for replies
+    _replyIP = packet.remoteIP;
+    _replyPort = packet.remotePort;
+
+    // accepted packets per second, counted over 1 second windows
+    _acceptedPackets++;
+    if (_lastUpdated_ms - _rateWindowStart_ms >= 1000)
+    {
+        _packetRate = _rateWindowCount;
+        _rateWindowCount = 0;
+        _rateWindowStart_ms = _lastUpdated_ms;
+    }
+    _rateWindowCount++;
+
+    if (sendValidationMessage)
+    {
+        sendReply(false);
+    }
+}
+
+void WiFi_Joystick_Controller::_updateRoundTrip(JsonObjectConst frame)
+{
+    // keep the sender timestamp to echo with the next reply
+    _echoValid = frame["ts"].is<uint32_t>();
+    if (_echoValid)
+    {
+        _echoTimestamp = frame["ts"];
+        _echoFrameId = frame["fid"];
+        _echoReceived_ms = _lastUpdated_ms;
+    }
+
+    // sender echoed one of our reply timestamps. Remove its own hold time to get the round trip time
+    if (frame["ets"].is<uint32_t>())
+    {
+        uint32_t elapsed_ms = (uint32_t)_now() - (uint32_t)frame["ets"];
+        uint32_t senderHold_ms = frame["eh"];
+        if (senderHold_ms <= elapsed_ms && (elapsed_ms - senderHold_ms) <= 0xFFFF)
+        {
+            _rttSamples[_rttIndex] = (uint16_t)(elapsed_ms - senderHold_ms);
+            _rttIndex = (_rttIndex + 1) % WJC_RTT_SAMPLES;
+            if (_rttCount < WJC_RTT_SAMPLES)
+            {
+                _rttCount++;
+            }
+        }
+    }
+}
+
 void WiFi_Joystick_Controller::_calcBtnValues(void)
 {
     if (_wjcData.btnGroupA.mode)
@@ -37,16 +37,11 @@
 #include <Arduino.h>
 #include <ArduinoJson.h> // special thanks to Benoit BLANCHON (https://arduinojson.org)
 
-// WiFi libraries
-#if defined(ARDUINO_ARCH_ESP32) || defined(ARDUINO_ARCH_ESP8266)
-#include <WiFi.h>
-#include <WiFiUdp.h>
-#elif defined(ARDUINO_SAMD_MKR1000)
-#include <WiFi101.h>
-#include <WiFiUdp.h>
-#else
-// TODO: reserved for future
-#endif
+// WiFi libraries and data packet transports
+#include "WJC_Transport.h"
+
+// network profile stores used by initFromProfile()
+#include "WJC_Profile_Store.h"
 
 // default return value if no errors detected
 constexpr uint8_t WJC_ERR_OK = 0;
@@ -80,6 +75,109 @@ constexpr uint8_t WJC_BTN_GROUP_VALUE = 2;
 constexpr uint8_t WJC_BTN_GROUP_SINGLE = 1; // only a single button can select at a time
 constexpr uint8_t WJC_BTN_GROUP_MULTI = 2;  // multiples buttons can be selected
 
+// round trip time selection
+constexpr uint8_t WJC_RTT_MIN = 1;
+constexpr uint8_t WJC_RTT_AVG = 2;
+constexpr uint8_t WJC_RTT_MAX = 3;
+
+// number of round trip time samples kept for min/avg/max
+constexpr uint8_t WJC_RTT_SAMPLES = 8;
+
+// session mode. Authenticated packets are laid out as
+// [0..7]  SipHash-2-4 tag (little-endian) calculated over bytes [8..] using the pre-shared key
+// [8..11] packet counter (little-endian), must increase within a session. Repeated copies of a packet keep its counter
+//         and are counted as duplicates (update() returns 6)
+// [12..]  regular JSON data packet
+// a session is pinned using a challenge. While no controller is pinned, the sender sends WJC_SESSION_CHALLENGE
+// followed by 4 padding bytes and the board answers with WJC_SESSION_CHALLENGE followed by a random nonce (little-endian).
+// The first authenticated packet must come from the same host with its counter equal to the nonce. A challenge pins
+// a single session, so captured packets cannot be replayed to take over a released session, even after a reset.
+// Nonces come from a hardware random number generator (ESP32, ESP8266, ATECC508A crypto chip of the MKR1000)
+constexpr uint8_t WJC_SESSION_KEY_SIZE = 16;
+constexpr uint8_t WJC_SESSION_HEADER_SIZE = 12;
+constexpr char WJC_SESSION_CHALLENGE[] = "WJSN";
+constexpr uint8_t WJC_SESSION_CHALLENGE_SIZE = 8;
+
+// protocol version and capability negotiation. Legacy senders skip it and keep using the baseline JSON packets
+// sender hello:  {"WJCH":<version>,"fmt":<formats>,"feat":<features>}
+// board ack:     {"WJCA":<version>,"fmt":<formats>,"feat":<features>,"rate":<max data rate Hz>}
+// sender select: {"WJCS":1,"fmt":<format>,"feat":<features>}
+// board confirm: {"WJCS":1,"fmt":<format>,"feat":<features>} with unsupported bits removed. "fmt" is 0 if refused,
+//                because another negotiated controller is sending valid data
+// the selection applies to packets from the selecting host only. Features it did not select are ignored in its packets
+// and packets of a format it did not select are rejected. Hosts without a handshake keep every supported feature
+constexpr uint8_t WJC_PROTOCOL_VERSION = 2;
+
+// data formats
+constexpr uint8_t WJC_FMT_JSON = 0x01;   // baseline JSON packets
+constexpr uint8_t WJC_FMT_BINARY = 0x02; // binary packets (burst frames)
+
+// protocol features
+constexpr uint16_t WJC_FEAT_FRAME_ID = 0x0001;  // "fid" frame IDs with duplicate drop
+constexpr uint16_t WJC_FEAT_REDUNDANT = 0x0002; // "prv" redundant copy of the previous frame
+constexpr uint16_t WJC_FEAT_TIMESTAMP = 0x0004; // "ts" timestamp echo and round trip time
+constexpr uint16_t WJC_FEAT_SESSION = 0x0008;   // authenticated session packets (only while a session key is set)
+constexpr uint16_t WJC_FEAT_STATS = 0x0010;     // health query (only while enabled)
+constexpr uint16_t WJC_FEAT_BURST = 0x0020;     // binary burst frames with several joystick samples
+
+// binary burst frame carrying several timestamped joystick samples (little-endian)
+// [0]      WJC_BURST_FRAME. JSON packets always start with '{'
+// [1..2]   frame ID
+// [3..6]   sender timestamp of the last sample in milliSeconds
+// [7]      button group A value
+// [8]      button group B value
+// [9]      button group modes (bit 0: group A multi, bit 1: group B multi)
+// [10]     number of samples (1 - WJC_BURST_MAX_SAMPLES)
+// [11..]   samples, oldest first. Each one is [age in milliSeconds before the last sample (2 bytes)][jsLx][jsLy][jsRx][jsRy]
+constexpr uint8_t WJC_BURST_FRAME = 0xB1;
+constexpr uint8_t WJC_BURST_HEADER_SIZE = 11;
+constexpr uint8_t WJC_BURST_SAMPLE_SIZE = 6;
+constexpr uint8_t WJC_BURST_MAX_SAMPLES = 31;
+
+// widest JSON data packet, all values at their widest. The frame has up to 14 members: "WJC", "fid", the 8 joystick
+// and button members, "ts", "ets", "eh" and "prv". The redundant copy in "prv" has up to 10 members: "WJC" (optional),
+// "fid" and the 8 joystick and button members. Timestamp tags are not copied into "prv"
+// {"WJC":true,<values><timestamp tags>,"prv":{"WJC":true,<values>}}
+constexpr char WJC_WIDEST_FRAME_VALUES[] = "\"fid\":65535,\"jsLx\":-128,\"jsLy\":-128,\"jsRx\":-128,\"jsRy\":-128,"
+                                           "\"bgA\":255,\"bgmA\":false,\"bgB\":255,\"bgmB\":false";
+constexpr char WJC_WIDEST_FRAME_TAGS[] = ",\"ts\":4294967295,\"ets\":4294967295,\"eh\":4294967295";
+constexpr uint16_t WJC_MAX_FRAME_SIZE = 2 * ((sizeof("{\"WJC\":true,") - 1) + (sizeof(WJC_WIDEST_FRAME_VALUES) - 1) + 1) +
+                                        (sizeof(WJC_WIDEST_FRAME_TAGS) - 1) + (sizeof(",\"prv\":") - 1);
+constexpr uint8_t WJC_FRAME_MEMBERS = 14;
+constexpr uint8_t WJC_PREV_FRAME_MEMBERS = 10;
+
+// transports must deliver the widest packets without truncating them
+static_assert(WJC_MAX_PACKET_SIZE >= WJC_SESSION_HEADER_SIZE + WJC_MAX_FRAME_SIZE, "WJC_MAX_PACKET_SIZE cannot hold a JSON frame with a redundant copy");
+static_assert(WJC_MAX_PACKET_SIZE >= WJC_SESSION_HEADER_SIZE + WJC_BURST_HEADER_SIZE + WJC_BURST_MAX_SAMPLES * WJC_BURST_SAMPLE_SIZE, "WJC_MAX_PACKET_SIZE cannot hold a full burst frame");
+
+// health query. A datagram holding exactly the WJC_STATS_QUERY bytes is answered with a binary record (little-endian)
+// in session mode the query must be authenticated like a data packet (session header followed by WJC_STATS_QUERY).
+// Its counter must increase from query to query, but is independent from the counter of the pinned controller
+// [0..3]   "WJSR"
+// [4]      record version (1)
+// [5]      flags (bit 0: data valid, bit 1: session pinned)
+// [6..9]   uptime in milliSeconds
+// [10..13] accepted data packets
+// [14..17] packets cannot deserialized (update() returned 3)
+// [18..21] packets cannot validated (update() returned 4)
+// [22..25] packets rejected by the session (update() returned 5)
+// [26..29] duplicate frames (update() returned 6)
+// [30..33] frames recovered from redundant copies
+// [34..35] accepted data packets per second
+// [36..39] age of the latest valid data in milliSeconds
+// [40..43] free heap in bytes (0 if not available)
+constexpr char WJC_STATS_QUERY[] = "WJSQ";
+constexpr uint8_t WJC_STATS_QUERY_SIZE = 4;
+constexpr uint8_t WJC_STATS_RECORD_SIZE = 44;
+
+// WiFi connection path used by initFromProfile()
+constexpr uint8_t WJC_CONNECT_NONE = 0; // not connected using initFromProfile()
+constexpr uint8_t WJC_CONNECT_FAST = 1; // direct connection using the stored profile
+constexpr uint8_t WJC_CONNECT_FULL = 2; // full scan and DHCP
+
+// time source returning milliSeconds. Defaults to millis(), can be replaced by a virtual clock for simulations
+typedef unsigned long (*WJC_Clock_t)(void);
+
 // structure to hold button group data
 typedef struct
 {
@@ -101,6 +199,37 @@ typedef struct
     WJC_Btn_Grp_t btnGroupB;
 } WJC_Remote_t;
 
+// structure to hold a joystick sample of a burst frame
+typedef struct
+{
+    unsigned long time_ms; // sample time on the instance clock
+    int8_t leftJoystickX;
+    int8_t leftJoystickY;
+    int8_t rightJoystickX;
+    int8_t rightJoystickY;
+} WJC_Sample_t;
+
+// structure to hold instance statistics
+typedef struct
+{
+    unsigned long uptime_ms;
+    uint32_t accepted;       // accepted data packets
+    uint32_t decodeErrors;   // packets cannot deserialized
+    uint32_t invalidPackets; // packets cannot validated
+    uint32_t sessionRejects; // packets rejected by the session
+    uint32_t duplicates;     // duplicate frames
+    uint32_t recovered;      // frames recovered from redundant copies
+    uint16_t packetRate;     // accepted data packets per second
+    unsigned long dataAge_ms;
+    uint32_t freeHeap;
+} WJC_Stats_t;
+
+// drive mixer base class (see WJC_Mixer.h)
+class WJC_Mixer;
+
+// frame history (see WJC_History.h)
+class WJC_History;
+
 class WiFi_Joystick_Controller
 {
 public:
@@ -111,6 +240,17 @@ public:
      */
     WiFi_Joystick_Controller(uint16_t udpPort);
 
+    /**
+     * @fn WiFi_Joystick_Controller
+     * @brief constructor using a different transport than UDP
+     * @param transport transport instance (see WJC_Transport.h)
+     * @n WJC_UDP_Transport one datagram per data packet (default)
+     * @n WJC_TCP_Transport length-prefixed data packets over a TCP stream
+     * @n WJC_Loopback_Transport in-memory packets injected by the sketch
+     * @param port desired port number for the transport socket
+     */
+    WiFi_Joystick_Controller(WJC_Transport *transport, uint16_t port);
+
     /**
      * @fn init
      * @brief initialize only the library instance. WiFi must enable separately (or using following init functions)
@@ -120,7 +260,7 @@ public:
      * @return initialization status
      * @retval 0 initialization succeeded
      * @retval 1 WiFi not initialized before
-     * @retval 2 UDP socket cannot initialized
+     * @retval 2 transport socket cannot initialized
      */
     uint8_t init(bool wifiInitialized);
 
@@ -138,13 +278,14 @@ public:
      * @retval 2 WiFi already initialized using the library
      * @retval 3 AP cannot initialized
      * @retval 4 cannot connected to the external network using given credentials
-     * @retval 5 UDP socket cannot initialized
+     * @retval 5 transport socket cannot initialized
      */
     uint8_t init(uint8_t mode, const char *ssid, const char *password);
 
     /**
      * @fn init
      * @brief initialize WiFi and connect to an external WiFi network using a predefined IP Address
+     * @n if a profile store is set, the connection is stored as a static profile for initFromProfile()
      * @param ssid name of the external WiFi network
      * @param password password of the external WiFi network
      * @param staticIP desired IP address for the development board
@@ -157,10 +298,55 @@ public:
      * @retval 1 WiFi already initialized using the library
      * @retval 2 WiFi cannot configure using given credentials
      * @retval 3 cannot connected to the external network using given credentials
-     * @retval 4 UDP socket cannot initialized
+     * @retval 4 transport socket cannot initialized
      */
     uint8_t init(const char *ssid, const char *password, IPAddress staticIP, IPAddress gateway, IPAddress subnet, IPAddress primaryDNS, IPAddress secondaryDNS);
 
+    /**
+     * @fn initFromProfile
+     * @brief initialize WiFi as a station using the network profile stored by the last successful connection
+     * @n the profile is used only if its SSID and port number match. The stored channel and BSSID skip the scan.
+     * @n A static profile stored by the static IP init() also skips DHCP. Other profiles keep using DHCP.
+     * @n If the direct connection fails, a full connection is made with the same IP configuration.
+     * @n The profile is stored again whenever the network details change
+     * @n (ESP32 and ESP8266 only. Needs a profile store, see setProfileStore(). Otherwise always a full connection)
+     * @param ssid name of the external WiFi network
+     * @param password password of the external WiFi network. Not stored
+     * @return initialization status
+     * @retval 0 initialization succeeded. See getConnectPath() for the path used
+     * @retval 1 WiFi already initialized using the library
+     * @retval 2 cannot connected to the external network using given credentials
+     * @retval 3 transport socket cannot initialized
+     */
+    uint8_t initFromProfile(const char *ssid, const char *password);
+
+    /**
+     * @fn getConnectPath
+     * @brief get the connection path used by initFromProfile()
+     * @return connection path
+     * @retval WJC_CONNECT_NONE initFromProfile() not used or failed
+     * @retval WJC_CONNECT_FAST connected directly using the stored profile
+     * @retval WJC_CONNECT_FULL connected with a full scan
+     */
+    uint8_t getConnectPath(void);
+
+    /**
+     * @fn setProfileStore
+     * @brief set where the network profile is stored. No profile is stored or used until a store is set
+     * @param store profile store instance (see WJC_Profile_Store.h). nullptr to stop using profiles
+     * @n WJC_NVS_Profile_Store NVS using Preferences (ESP32)
+     * @n WJC_EEPROM_Profile_Store emulated EEPROM at the given address, shared with the sketch (ESP8266)
+     * @n WJC_File_Profile_Store file on a mounted file system (ESP32, ESP8266)
+     * @n WJC_Memory_Profile_Store RAM only, lost on reset
+     */
+    void setProfileStore(WJC_Profile_Store *store);
+
+    /**
+     * @fn clearStoredProfile
+     * @brief erase the network profile of the profile store. Next initFromProfile() makes a full connection
+     */
+    void clearStoredProfile(void);
+
     /**
      * @fn update
      * @brief read the latest received data and store in data holding variables
@@ -171,9 +357,174 @@ public:
      * @retval 2 no data packet received since last read
      * @retval 3 cannot deserialize received data packet
      * @retval 4 data cannot validated
+     * @retval 5 data packet rejected by the session (not from the pinned controller or not authenticated)
+     * @retval 6 duplicate of an already applied frame (in session mode also an authenticated copy of the last packet)
+     * @retval 7 health query answered (see setStatsQuery). Data holding variables are not changed
+     * @retval 8 handshake packet answered (see WJC_PROTOCOL_VERSION). Data holding variables are not changed
+     * @retval 9 session challenge answered (see setSessionKey). Data holding variables are not changed
+     * @n frames with a "fid" (frame ID) tag are applied once. If a frame is lost and the next packet carries
+     * @n a redundant copy of it in "prv", the copy is applied first. "prv" holds "fid", "jsLx", "jsLy", "jsRx", "jsRy",
+     * @n "bgA", "bgmA", "bgB", "bgmB" and optionally "WJC". Do not copy "ts", "ets" or "eh" into it. Extra members
+     * @n do not fit the decode buffer and the whole packet is rejected with 3 (see WJC_MAX_FRAME_SIZE)
      */
     uint8_t update(bool sendValidationMessage = true);
 
+    /**
+     * @fn getRemoteData
+     * @brief get the entire controller data at once
+     * @return latest controller data
+     */
+    const WJC_Remote_t &getRemoteData(void);
+
+    /**
+     * @fn getFrameCount
+     * @brief get the number of frames applied since start. Can use to detect new data without comparing values
+     * @return applied frame count
+     */
+    uint32_t getFrameCount(void);
+
+    /**
+     * @fn setMixer
+     * @brief run a drive mixer once for every accepted packet. Outputs are ready when update() returns 0
+     * @n outputs are set to neutral right away and again by update() once the data validation period expires
+     * @param mixer mixer instance (see WJC_Mixer.h). Pass nullptr to disable mixing
+     * @param outputs output array with at least mixer->getOutputCount() elements
+     */
+    void setMixer(WJC_Mixer *mixer, int16_t *outputs);
+
+    /**
+     * @fn setHistory
+     * @brief record every applied frame with its receive time
+     * @param history history instance (see WJC_History.h). Pass nullptr to disable recording
+     */
+    void setHistory(WJC_History *history);
+
+    /**
+     * @fn getRecoveredFrameCount
+     * @brief get the number of lost frames filled from redundant copies
+     * @return recovered frame count
+     */
+    uint32_t getRecoveredFrameCount(void);
+
+    /**
+     * @fn getDuplicateFrameCount
+     * @brief get the number of duplicate frames received and dropped
+     * @return duplicate frame count
+     */
+    uint32_t getDuplicateFrameCount(void);
+
+    /**
+     * @fn getStats
+     * @brief get packet statistics of the instance
+     * @param stats statistics holding variable
+     */
+    void getStats(WJC_Stats_t &stats);
+
+    /**
+     * @fn setStatsQuery
+     * @brief answer health query datagrams (WJC_STATS_QUERY) with a binary statistics record. Disabled by default
+     * @n queries never change the control data. Without session mode any host can query, so use it only on
+     * @n trusted networks. In session mode only authenticated queries are answered (see WJC_STATS_QUERY)
+     * @param enable true to answer health queries
+     */
+    void setStatsQuery(bool enable);
+
+    /**
+     * @fn setSampleBuffer
+     * @brief keep every joystick sample of burst frames for the sketch. Latest sample is always applied
+     * @n to the data holding variables, with or without a sample buffer
+     * @param buffer sample array owned by the sketch. Pass nullptr to disable sample buffering
+     * @param capacity number of samples in the array. Oldest samples are overwritten if not read in time
+     */
+    void setSampleBuffer(WJC_Sample_t *buffer, uint16_t capacity);
+
+    /**
+     * @fn getSampleCount
+     * @brief get the number of buffered samples not read yet
+     * @return buffered sample count
+     */
+    uint16_t getSampleCount(void);
+
+    /**
+     * @fn readSample
+     * @brief read the oldest buffered sample
+     * @param sample sample holding variable
+     * @return read status
+     * @retval 0 sample read
+     * @retval 1 no sample buffered
+     */
+    uint8_t readSample(WJC_Sample_t &sample);
+
+    /**
+     * @fn setMaxDataRate
+     * @brief set the data rate advertised during the handshake. Default rate is 20Hz
+     * @n keep it below half of the update() call rate
+     * @param rate_hz highest data packet rate the sketch can handle
+     */
+    void setMaxDataRate(uint16_t rate_hz);
+
+    /**
+     * @fn getNegotiatedFormat
+     * @brief get the data format selected by the negotiated sender during the handshake
+     * @return selected data format
+     * @retval 0 no handshake. Sender uses the baseline JSON packets
+     * @retval WJC_FMT_JSON JSON packets
+     * @retval WJC_FMT_BINARY binary packets
+     */
+    uint8_t getNegotiatedFormat(void);
+
+    /**
+     * @fn getNegotiatedFeatures
+     * @brief get the protocol features selected by the negotiated sender during the handshake
+     * @return bitmask of WJC_FEAT_ values. 0 if no handshake
+     */
+    uint16_t getNegotiatedFeatures(void);
+
+    /**
+     * @fn setSessionKey
+     * @brief enable session mode. The sender requests a challenge and its first authenticated packet answering
+     * @n the challenge pins the instance to it. Packets from any other host are dropped before reading
+     * @n challenges need a hardware random number generator. MKR1000 uses its ATECC508A crypto chip, which gives
+     * @n random numbers only after its configuration is locked (e.g. using the ArduinoECCX08 ECCX08CSR example)
+     * @param key pre-shared key of WJC_SESSION_KEY_SIZE bytes. Pass nullptr to disable session mode
+     * @return status
+     * @retval 0 session mode enabled or disabled
+     * @retval 1 no usable random number generator. Session mode stays enabled but no challenge is answered,
+     * @n so no controller can pin and every data packet is rejected
+     */
+    uint8_t setSessionKey(const uint8_t *key);
+
+    /**
+     * @fn setSessionTimeout
+     * @brief set the idle period after which a pinned session is released. Default timeout is 3000mS.
+     * @param timeout_ms timeout in milliSeconds
+     */
+    void setSessionTimeout(uint16_t timeout_ms);
+
+    /**
+     * @fn releaseSession
+     * @brief release the pinned controller so a new one can start a session with a new challenge
+     */
+    void releaseSession(void);
+
+    /**
+     * @fn getSessionStatus
+     * @brief check if the instance is pinned to a controller
+     * @return session status
+     * @retval 0 session pinned to a controller
+     * @retval 1 no active session
+     */
+    uint8_t getSessionStatus(void);
+
+    /**
+     * @fn calcPacketTag
+     * @brief calculate SipHash-2-4 of the given data using the session key. Can use to build authenticated packets
+     * @param data data to authenticate (packet bytes from the counter onwards)
+     * @param length length of the data
+     * @return 64-bit tag
+     */
+    uint64_t calcPacketTag(const uint8_t *data, uint16_t length);
+
     /**
      * @fn setDataValidTimeout
      * @brief set the timeout for the getDataValidStatus()
@@ -190,6 +541,20 @@ public:
      */
     uint8_t getDataValidStatus(void);
 
+    /**
+     * @fn getDataAge
+     * @brief get the time since the last valid data packet
+     * @return age of the latest data in milliSeconds
+     */
+    unsigned long getDataAge(void);
+
+    /**
+     * @fn setClock
+     * @brief replace millis() as the time source of the instance. Timeouts, timestamps and replies follow the given clock
+     * @param clock time source. Pass nullptr to use millis() again
+     */
+    void setClock(WJC_Clock_t clock);
+
     /**
      * @fn getJoystick
      * @brief get joystick axis values
@@ -244,10 +609,24 @@ public:
     /**
      * @fn sendReply
      * @brief send data to mobile app
+     * @n if the last frame carried a "ts" (sender timestamp) tag, the reply echoes it with "fid", the "hold" time
+     * @n between receiving the frame and sending the reply, and "bts" (board timestamp). The sender can return
+     * @n "bts" as "ets" with its own hold time as "eh" to let the board measure the round trip time
      * @param sendImmediately send data without any skipping
      */
     void sendReply(bool sendImmediately);
 
+    /**
+     * @fn getRoundTripTime
+     * @brief get the round trip time over the last WJC_RTT_SAMPLES echoed timestamps
+     * @param whichValue selected value
+     * @n WJC_RTT_MIN to select minimum round trip time
+     * @n WJC_RTT_AVG to select average round trip time
+     * @n WJC_RTT_MAX to select maximum round trip time
+     * @return round trip time in milliSeconds. 0 if no timestamps echoed yet
+     */
+    uint16_t getRoundTripTime(uint8_t whichValue);
+
     /**
      * @fn getIpAddress
      * @brief get the IP address of the development board
@@ -257,7 +636,7 @@ public:
 
     /**
      * @fn getPortNumber
-     * @brief get port number of the UDP socket
+     * @brief get port number of the transport socket
      * @return local port number
      */
     uint16_t getPortNumber(void);
@@ -286,14 +665,164 @@ private:
     uint8_t _initSTA(const char *ssid, const char *password);
 
     /**
-     * @fn _initUDP
-     * @brief initialize UDP socket
+     * @fn _initFastSTA
+     * @brief connect to the external network directly using a stored profile
+     * @param profile stored network profile
+     * @param password password of the external WiFi network
+     * @return initialization status
+     * @retval 0 connected to the external network
+     * @retval 1 cannot connect to the external network
+     */
+    uint8_t _initFastSTA(const WJC_Profile_t &profile, const char *password);
+
+    /**
+     * @fn _applyProfileConfig
+     * @brief apply the IP configuration of a profile. Static profiles set their stored IP addresses, others use DHCP
+     * @param profile network profile
+     * @return configuration status
+     * @retval 0 configuration applied
+     * @retval 1 configuration failed
+     */
+    uint8_t _applyProfileConfig(const WJC_Profile_t &profile);
+
+    /**
+     * @fn _loadProfile
+     * @brief read and validate the network profile of the profile store
+     * @param profile profile holding variable
+     * @return load status
+     * @retval 0 valid profile loaded
+     * @retval 1 no profile store or no valid profile stored
+     */
+    uint8_t _loadProfile(WJC_Profile_t &profile);
+
+    /**
+     * @fn _saveProfile
+     * @brief store the network profile of the current connection if it changed
+     * @param ipMode IP configuration of the connection
+     * @n WJC_PROFILE_DHCP only the SSID, channel, BSSID and port are stored
+     * @n WJC_PROFILE_STATIC the IP addresses are stored as well
+     */
+    void _saveProfile(uint8_t ipMode);
+
+    /**
+     * @fn _calcProfileChecksum
+     * @brief calculate Fletcher-16 checksum of a profile, excluding the checksum field
+     * @param profile network profile
+     * @return checksum
+     */
+    uint16_t _calcProfileChecksum(const WJC_Profile_t &profile);
+
+    /**
+     * @fn _initTransport
+     * @brief initialize transport socket
      * @return initialization status
      * @retval 0 initialization succeeded
      * @retval 1 provided port number is wrong
      * @retval 2 initialization failed
      */
-    uint8_t _initUDP(void);
+    uint8_t _initTransport(void);
+
+    /**
+     * @fn _handleHandshake
+     * @brief answer hello and select packets of the capability negotiation
+     * @param frame JSON object of the packet
+     * @param packet received packet
+     * @return handshake status
+     * @retval 0 handshake packet answered
+     * @retval 1 not a handshake packet
+     */
+    uint8_t _handleHandshake(JsonObjectConst frame, const WJC_Packet_t &packet);
+
+    /**
+     * @fn _isNegotiatedSender
+     * @brief check if a packet comes from the host which selected the negotiated format and features
+     * @param packet received packet
+     * @return true if the packet comes from the negotiated sender
+     */
+    bool _isNegotiatedSender(const WJC_Packet_t &packet);
+
+    /**
+     * @fn _getSupportedFeatures
+     * @brief get the protocol features currently supported by the instance
+     * @return bitmask of WJC_FEAT_ values
+     */
+    uint16_t _getSupportedFeatures(void);
+
+    /**
+     * @fn _checkStatsQuery
+     * @brief authenticate a health query in session mode. Does not change the session
+     * @param packet received query including the session header
+     * @return authentication status
+     * @retval 0 query authenticated
+     * @retval 1 replayed query counter
+     * @retval 2 tag mismatch
+     */
+    uint8_t _checkStatsQuery(const WJC_Packet_t &packet);
+
+    /**
+     * @fn _sendStats
+     * @brief send the binary statistics record
+     * @param remoteIP destination IP address
+     * @param remotePort destination port number
+     */
+    void _sendStats(IPAddress remoteIP, uint16_t remotePort);
+
+    /**
+     * @fn _now
+     * @brief get the current time from the instance clock
+     * @return current time in milliSeconds
+     */
+    unsigned long _now(void);
+
+    /**
+     * @fn _decodeFrame
+     * @brief decode a frame into data holding variables
+     * @param frame JSON object of the frame
+     */
+    void _decodeFrame(JsonObjectConst frame);
+
+    /**
+     * @fn _updateRoundTrip
+     * @brief keep the sender timestamp for the next reply and take round trip time samples
+     * @param frame JSON object of the frame
+     */
+    void _updateRoundTrip(JsonObjectConst frame);
+
+    /**
+     * @fn _decodeBurst
+     * @brief decode a binary burst frame into data holding variables and the sample buffer
+     * @param data burst frame
+     * @param length length of the burst frame
+     * @param features protocol features enabled for the sender (WJC_FEAT_FRAME_ID and WJC_FEAT_TIMESTAMP are used)
+     * @return decode status
+     * @retval 0 frame applied
+     * @retval 3 frame is malformed
+     * @retval 6 duplicate of an already applied frame
+     */
+    uint8_t _decodeBurst(const uint8_t *data, uint16_t length, uint16_t features);
+
+    /**
+     * @fn _isDuplicateFrame
+     * @brief check a frame ID against the last applied one and count duplicates
+     * @param frameId frame ID of the received frame
+     * @return true if the frame was already applied
+     */
+    bool _isDuplicateFrame(uint16_t frameId);
+
+    /**
+     * @fn _commitFrame
+     * @brief finish applying a decoded frame
+     * @param received_ms receive time of the frame
+     */
+    void _commitFrame(unsigned long received_ms);
+
+    /**
+     * @fn _acceptPacket
+     * @brief run the per packet work after an accepted data packet
+     * @param packet received packet
+     * @param sendValidationMessage send a reply to the mobile app
+     */
+    void _acceptPacket(const WJC_Packet_t &packet, bool sendValidationMessage);
 
     /**
      * @fn _calcBtnValues
@@ -301,22 +830,128 @@ private:
      */
     void _calcBtnValues(void);
 
+    /**
+     * @fn _checkSession
+     * @brief authenticate a received packet and pin the session to its sender
+     * @param packet received packet including the session header
+     * @return authentication status
+     * @retval 0 packet authenticated
+     * @retval 1 packet too short
+     * @retval 2 tag mismatch
+     * @retval 3 replayed packet counter
+     * @retval 4 no matching challenge to pin the session
+     * @retval 5 authenticated copy of the last accepted packet
+     */
+    uint8_t _checkSession(const WJC_Packet_t &packet);
+
+    /**
+     * @fn _sendChallenge
+     * @brief issue a new session challenge to the sender of the packet. Replaces any earlier challenge
+     * @param packet received challenge request
+     */
+    void _sendChallenge(const WJC_Packet_t &packet);
+
     // joystick controller data holding variable
-    WJC_Remote_t _wjcData;
+    WJC_Remote_t _wjcData = {};
 
-    // UDP socket instance
-    WiFiUDP _UDP;
+    // transport in use. Points to the built-in UDP transport unless another one is given
+    WJC_UDP_Transport _udpTransport;
+    WJC_Transport *_transport;
 
-    // UDP port number
+    // transport port number
     uint16_t _port = 0;
 
     // local IP address
     IPAddress _ipAddress = IPAddress(0, 0, 0, 0);
 
+    // connection path used by initFromProfile()
+    uint8_t _connectPath = WJC_CONNECT_NONE;
+
+    // network profile storage. No profile is used if not set
+    WJC_Profile_Store *_profileStore = nullptr;
+
     // time flag of the last successful updated
     uint16_t _dataValidTime_ms = 500;
     unsigned long _lastUpdated_ms;
 
+    // time source. millis() if not set
+    WJC_Clock_t _clock = nullptr;
+
+    // number of replies skipped since the last sent one
+    uint8_t _replySkipper = 0;
+
+    // address of the last accepted sender. Replies go here instead of the last received packet
+    IPAddress _replyIP = IPAddress(0, 0, 0, 0);
+    uint16_t _replyPort = 0;
+
+    // number of applied frames
+    uint32_t _frameCount = 0;
+
+    // burst frame sample buffer owned by the sketch
+    WJC_Sample_t *_samples = nullptr;
+    uint16_t _sampleCapacity = 0;
+    uint16_t _sampleHead = 0;
+    uint16_t _sampleCount = 0;
+
+    // capability negotiation
+    uint16_t _maxDataRate_hz = 20;
+    uint8_t _negotiatedFormat = 0;
+    uint16_t _negotiatedFeatures = 0;
+    IPAddress _negotiatedIP = IPAddress(0, 0, 0, 0);
+    uint16_t _negotiatedPort = 0;
+
+    // packet statistics
+    bool _statsQueryEnabled = false;
+    uint32_t _statsQueryCounter = 0;
+    uint32_t _acceptedPackets = 0;
+    uint32_t _decodeErrors = 0;
+    uint32_t _invalidPackets = 0;
+    uint32_t _sessionRejects = 0;
+    uint16_t _packetRate = 0;
+    uint16_t _rateWindowCount = 0;
+    unsigned long _rateWindowStart_ms = 0;
+
+    // drive mixer and its output array
+    WJC_Mixer *_mixer = nullptr;
+    int16_t *_mixerOutputs = nullptr;
+    bool _mixerNeutral = true; // outputs hold the neutral values
+
+    // frame history
+    WJC_History *_history = nullptr;
+
+    // frame ID tracking for duplicate and redundant frames
+    bool _frameIdValid = false;
+    uint16_t _lastFrameId = 0;
+    uint32_t _recoveredFrames = 0;
+    uint32_t _duplicateFrames = 0;
+
+    // timestamp echo and round trip time samples
+    bool _echoValid = false;
+    uint32_t _echoTimestamp = 0;
+    uint16_t _echoFrameId = 0;
+    unsigned long _echoReceived_ms = 0;
+    uint16_t _rttSamples[WJC_RTT_SAMPLES];
+    uint8_t _rttIndex = 0;
+    uint8_t _rttCount = 0;
+
+    // session mode variables
+    bool _sessionEnabled = false;
+    bool _sessionPinned = false;
+    uint8_t _sessionKey[WJC_SESSION_KEY_SIZE];
+    IPAddress _sessionIP = IPAddress(0, 0, 0, 0);
+    uint16_t _sessionPort = 0;
+    uint32_t _sessionCounter = 0;
+    uint16_t _sessionTimeout_ms = 3000;
+    unsigned long _sessionLastSeen_ms = 0;
+
+    // session challenge waiting for its first authenticated packet
+    bool _challengeAvailable = false; // random number generator usable for nonces
+    bool _challengeValid = false;
+    uint32_t _challengeNonce = 0;
+    IPAddress _challengeIP = IPAddress(0, 0, 0, 0);
+    uint16_t _challengePort = 0;
+    unsigned long _challengeIssued_ms = 0;
+
     // WiFi init flag. This variable will be shared between all of the library instances
     static bool WJC_WIFI_INIT;
 };